@@ -0,0 +1,977 @@
+/************************************************************************/
+/* Benchmarks of the convex hull engines                                */
+/*                                                                      */
+/* Usage: ConvexHull3DBench <vertex list file | sphere:N | cube:N>      */
+/*                          [case name filter]                          */
+/*                                                                      */
+/* Cache misses are read from hardware counters on Linux (they show as  */
+/* "n/a" elsewhere, or when perf events are not allowed).               */
+/************************************************************************/
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "ConvexHull3D.h"
+#include "FrozenHull.h"
+#include "HullClassifier.h"
+#include "HullCollision.h"
+#include "HullRayCaster.h"
+#include "HullSupport.h"
+#include "MassProperties.h"
+#include "OrientedBox.h"
+#include "MeshWriter.h"
+
+std::vector<sPoint> g_InputPts;
+std::string         g_Filter;
+
+/************************************************************************/
+/*                          CacheMissCounter                            */
+/************************************************************************/
+
+struct CacheMissCounter
+{
+    int m_FD;
+
+    CacheMissCounter() : m_FD(-1)
+    {
+#ifdef __linux__
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        m_FD = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+
+    ~CacheMissCounter()
+    {
+#ifdef __linux__
+        if (m_FD >= 0) {
+            close(m_FD);
+        }
+#endif
+    }
+
+    void start()
+    {
+#ifdef __linux__
+        if (m_FD >= 0) {
+            ioctl(m_FD, PERF_EVENT_IOC_RESET, 0);
+            ioctl(m_FD, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    // Returns a negative value if counters are unavailable
+    long long stop()
+    {
+        long long count(-1);
+#ifdef __linux__
+        if (m_FD >= 0) {
+            ioctl(m_FD, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(m_FD, &count, sizeof(count)) != sizeof(count)) {
+                count = -1;
+            }
+        }
+#endif
+        return count;
+    }
+};
+
+
+/************************************************************************/
+/*                               Input                                  */
+/************************************************************************/
+
+void readVertexFile(const char* i_Filepath)
+{
+    std::ifstream file(i_Filepath);
+    if (!file) {
+        std::cerr << "Invalid file \"" << i_Filepath << "\"" << std::endl;
+        exit(1);
+    }
+
+    double x, y, z;
+    while (file >> x >> y >> z) {
+        g_InputPts.emplace_back(new Point(x, y, z));
+    }
+}
+
+void generatePoints(const std::string& i_Shape, uint i_NbPts)
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> uni(-1, 1);
+
+    for (uint i = 0; i < i_NbPts; ++i) {
+        Vector v(uni(rng), uni(rng), uni(rng));
+        if (i_Shape == "sphere") {
+            // Points on a (slightly noisy) sphere: nearly all on the hull
+            v = v.normalize() * (100 + uni(rng) * 1e-3);
+        } else {
+            v *= 100;
+        }
+        g_InputPts.emplace_back(new Point(v.m_x, v.m_y, v.m_z));
+    }
+}
+
+
+/************************************************************************/
+/*                               Cases                                  */
+/************************************************************************/
+
+void printHeader()
+{
+    printf("%-32s %10s %14s %10s\n", "case", "time (ms)", "cache misses", "facets");
+}
+
+void runCase(const std::string& i_Name, std::function<void()> i_Setup)
+{
+    if (i_Name.find(g_Filter) == std::string::npos) {
+        return;
+    }
+
+    // Reset the engine settings and input
+    g_Pts = g_InputPts;
+    g_Engine = CONFLICT_GRAPH;
+    g_InsertionOrder = RANDOM_ORDER;
+    g_RemoveDuplicates = false;
+    g_UseFloat = false;
+    g_GridStep = 0;
+    g_CoplanarMergeAngle = -1;
+    g_CoplanarMergeDistance = -1;
+    g_KernelEpsilon = 0;
+    g_AutoSelect = false;
+    g_ComputeMembership = false;
+    g_ParallelHorizonThreshold = 128;
+    i_Setup();
+
+    CacheMissCounter counter;
+    counter.start();
+    std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+
+    compute3DConvexHull();
+
+    std::chrono::steady_clock::time_point end(std::chrono::steady_clock::now());
+    long long cacheMisses(counter.stop());
+
+    uint nbFacets(0);
+    if (g_ConvexHull) {
+        for (const sptr<Facet>& facet : g_ConvexHull->m_Facets) {
+            nbFacets += facet ? 1 : 0;
+        }
+    }
+
+    printf("%-32s %10.1f ", i_Name.c_str(),
+           std::chrono::duration<double, std::milli>(end - start).count());
+    if (cacheMisses >= 0) {
+        printf("%14lld ", cacheMisses);
+    } else {
+        printf("%14s ", "n/a");
+    }
+    printf("%10u\n", nbFacets);
+}
+
+void benchInsertionOrders()
+{
+    Engine engines[] = { CONFLICT_GRAPH, LOW_MEMORY, HISTORY_DAG };
+    const char* names[] = { "conflict graph", "low memory", "history DAG" };
+
+    for (int i = 0; i < 3; ++i) {
+        runCase(std::string("order/random/") + names[i], [&]() {
+            g_Engine = engines[i];
+        });
+        runCase(std::string("order/brio/") + names[i], [&]() {
+            g_Engine = engines[i];
+            g_InsertionOrder = BRIO_ORDER;
+        });
+    }
+}
+
+void benchEngines()
+{
+    runCase("engine/triangle mesh", []() {
+        g_Engine = TRIANGLE_MESH;
+    });
+    runCase("engine/output sensitive", []() {
+        g_Engine = OUTPUT_SENSITIVE;
+    });
+    runCase("engine/auto", []() {
+        g_AutoSelect = true;
+    });
+    runCase("engine/triangle mesh (float)", []() {
+        g_Engine = TRIANGLE_MESH;
+        g_UseFloat = true;
+    });
+    runCase("engine/triangle mesh (grid 1e-3)", []() {
+        g_Engine = TRIANGLE_MESH;
+        g_GridStep = 1e-3;
+    });
+    runCase("merge/triangle mesh (grid 1)", []() {
+        g_Engine = TRIANGLE_MESH;
+        g_GridStep = 1;
+        g_CoplanarMergeAngle = 1e-6;
+    });
+    runCase("merge/triangle mesh (5 degrees)", []() {
+        g_Engine = TRIANGLE_MESH;
+        g_CoplanarMergeAngle = 5 * acos(-1.0) / 180;
+    });
+
+    // Tracked by the engine, or classified against the hull
+    runCase("membership/triangle mesh", []() {
+        g_Engine = TRIANGLE_MESH;
+        g_ComputeMembership = true;
+    });
+    runCase("membership/output sensitive", []() {
+        g_Engine = OUTPUT_SENSITIVE;
+        g_ComputeMembership = true;
+    });
+}
+
+void benchWriters()
+{
+    if (std::string("write/obj write/ply write/stl").find(g_Filter) == std::string::npos) {
+        return;
+    }
+
+    // Triangulated hull of the input
+    g_Pts = g_InputPts;
+    g_Engine = TRIANGLE_MESH;
+    g_UseFloat = false;
+    g_GridStep = 0;
+    compute3DConvexHull();
+    if (!g_ConvexHull) {
+        return;
+    }
+    Mesh mesh(exportMesh(*g_ConvexHull));
+
+    const char* formats[] = { "obj", "ply", "stl" };
+    for (const char* format : formats) {
+        std::string name(std::string("write/") + format);
+        if (name.find(g_Filter) == std::string::npos) {
+            continue;
+        }
+
+        std::string filepath(std::string("bench_hull.") + format);
+        std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+        writeMesh(mesh, filepath);
+        std::chrono::steady_clock::time_point end(std::chrono::steady_clock::now());
+        remove(filepath.c_str());
+
+        printf("%-32s %10.1f %14s %10u\n", name.c_str(),
+               std::chrono::duration<double, std::milli>(end - start).count(), "", mesh.nbFacets());
+    }
+}
+
+void printTimedCase(const std::string& i_Name, std::chrono::steady_clock::time_point i_Start, uint i_Count)
+{
+    std::chrono::steady_clock::time_point end(std::chrono::steady_clock::now());
+    printf("%-32s %10.1f %14s %10u\n", i_Name.c_str(),
+           std::chrono::duration<double, std::milli>(end - i_Start).count(), "", i_Count);
+}
+
+// Input points (as the engine left them: -float and -grid round them) above
+// a facet plane of the hull by more than 1e-9 of the bounding box diagonal:
+// the hull then missed a vertex or has a facet folded inward
+uint countPointsOutside()
+{
+    if (!g_ConvexHull) {
+        return 0;
+    }
+    HullClassifier bounds(*g_ConvexHull);
+    double tolerance(1e-9 * (bounds.m_Max - bounds.m_Min).norm());
+    std::vector<sptr<Facet>> facets;
+    for (const sptr<Facet>& facet : g_ConvexHull->m_Facets) {
+        if (facet) {
+            facets.push_back(facet);
+        }
+    }
+
+    // Planes from the vertices, with points taken relative to a vertex so
+    // that the distance to the origin does not add rounding errors
+    std::vector<char> isOutside(g_Pts.size(), 0);
+    parallelFor(0, g_Pts.size(), [&](uint, uint i_Begin, uint i_End) {
+        for (const sptr<Facet>& facet : facets) {
+            const Point& a(*facet->m_AnEdge->m_Origin);
+            Vector normal(cross(*facet->m_AnEdge->m_Next->m_Origin - a, *facet->m_AnEdge->m_Next->m_Next->m_Origin - a));
+            normal = normal.normalize();
+            for (uint i = i_Begin; i < i_End; ++i) {
+                isOutside[i] |= dot(normal, *g_Pts[i] - a) > tolerance ? 1 : 0;
+            }
+        }
+    });
+    return std::count(isOutside.begin(), isOutside.end(), 1);
+}
+
+void benchValidity()
+{
+    if (std::string("valid/").find(g_Filter) == std::string::npos && g_Filter.find("valid/") != 0) {
+        return;
+    }
+
+    // Points of a unit sphere centered at (1000, 1000, 1000): neighbors are
+    // closer than the rounding errors of plane offsets taken from the origin
+    std::vector<sPoint> inputPts;
+    inputPts.swap(g_InputPts);
+    std::mt19937 rng(5);
+    std::normal_distribution<double> normal;
+    for (uint i = 0; i < 20000; ++i) {
+        Vector v(Vector(normal(rng), normal(rng), normal(rng)).normalize());
+        g_InputPts.emplace_back(new Point(1000 + v.m_x, 1000 + v.m_y, 1000 + v.m_z));
+    }
+
+    runCase("valid/triangle mesh", []() {
+        g_Engine = TRIANGLE_MESH;
+    });
+    std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+    printTimedCase("valid/triangle mesh (wrong)", start, countPointsOutside());
+
+    runCase("valid/float", []() {
+        g_Engine = TRIANGLE_MESH;
+        g_UseFloat = true;
+    });
+    start = std::chrono::steady_clock::now();
+    printTimedCase("valid/float (wrong)", start, countPointsOutside());
+
+    runCase("valid/output sensitive", []() {
+        g_Engine = OUTPUT_SENSITIVE;
+    });
+    start = std::chrono::steady_clock::now();
+    printTimedCase("valid/output sensitive (wrong)", start, countPointsOutside());
+
+    g_InputPts.swap(inputPts);
+}
+
+// Cost of a pass over nothing, through the worker pool or on new threads, and
+// the conflict graph engine for several horizon sizes from which new conflicts
+// are found in parallel. Only meaningful with several threads.
+void benchParallelHorizon()
+{
+    if (std::string("horizon/").find(g_Filter) == std::string::npos && g_Filter.find("horizon/") != 0) {
+        return;
+    }
+
+    const uint nbPasses(1000);
+    std::vector<uint> counts(nbThreads());
+    std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+    for (uint pass = 0; pass < nbPasses; ++pass) {
+        parallelFor(0, nbThreads(), [&](uint i_ThreadID, uint, uint) {
+            ++counts[i_ThreadID];
+        });
+    }
+    printTimedCase("horizon/empty passes (pool)", start, nbPasses);
+
+    start = std::chrono::steady_clock::now();
+    for (uint pass = 0; pass < nbPasses; ++pass) {
+        std::vector<std::thread> threads;
+        for (uint t = 1; t < nbThreads(); ++t) {
+            threads.emplace_back([&counts, t]() {
+                ++counts[t];
+            });
+        }
+        ++counts[0];
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+    printTimedCase("horizon/empty passes (spawn)", start, nbPasses);
+
+    runCase("horizon/serial", []() {
+        g_ParallelHorizonThreshold = std::numeric_limits<uint>::max();
+    });
+    uint thresholds[] = { 16, 32, 64, 128, 256, 1024 };
+    for (uint threshold : thresholds) {
+        runCase("horizon/from " + std::to_string(threshold) + " facets", [threshold]() {
+            g_ParallelHorizonThreshold = threshold;
+        });
+    }
+}
+
+void benchQueries()
+{
+    if (std::string("query/").find(g_Filter) == std::string::npos && g_Filter.find("query/") != 0) {
+        return;
+    }
+
+    g_Pts = g_InputPts;
+    g_Engine = TRIANGLE_MESH;
+    g_UseFloat = false;
+    g_GridStep = 0;
+    g_CoplanarMergeAngle = -1;
+    compute3DConvexHull();
+    if (!g_ConvexHull) {
+        return;
+    }
+
+    // Queries uniformly spread over the enlarged bounding box
+    HullClassifier classifier(*g_ConvexHull);
+    Vector margin((classifier.m_Max - classifier.m_Min) * 0.1);
+    Point low(classifier.m_Min - margin);
+    Point high(classifier.m_Max + margin);
+    std::mt19937 rng(7);
+    std::vector<Point> queries(4000000);
+    for (Point& query : queries) {
+        for (int axis = 0; axis < 3; ++axis) {
+            query[axis] = std::uniform_real_distribution<double>(low[axis], high[axis])(rng);
+        }
+    }
+    std::vector<unsigned char> locations(queries.size());
+
+    std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+    HullClassifier built(*g_ConvexHull);
+    printTimedCase("query/build planes", start, built.m_NbFacets);
+
+    start = std::chrono::steady_clock::now();
+    classifier.classify(queries.data(), queries.size(), locations.data());
+    uint nbInside(std::count(locations.begin(), locations.end(), (unsigned char)INSIDE));
+    printTimedCase("query/classify 4M (inside)", start, nbInside);
+
+    // Reference: Facet::isVisibleBy on every facet, for a few queries
+    uint nbNaive(queries.size() / 100);
+    start = std::chrono::steady_clock::now();
+    uint nbNaiveInside(0);
+    for (uint i = 0; i < nbNaive; ++i) {
+        sPoint query(new Point(queries[i]));
+        bool isOutside(false);
+        for (const sptr<Facet>& facet : g_ConvexHull->m_Facets) {
+            if (facet && facet->isVisibleBy(query)) {
+                isOutside = true;
+                break;
+            }
+        }
+        nbNaiveInside += isOutside ? 0 : 1;
+    }
+    printTimedCase("query/naive DCEL 40k (inside)", start, nbNaiveInside);
+}
+
+void benchSupport()
+{
+    if (std::string("support/").find(g_Filter) == std::string::npos && g_Filter.find("support/") != 0) {
+        return;
+    }
+
+    g_Pts = g_InputPts;
+    g_Engine = TRIANGLE_MESH;
+    g_UseFloat = false;
+    g_GridStep = 0;
+    g_CoplanarMergeAngle = -1;
+    compute3DConvexHull();
+    if (!g_ConvexHull) {
+        return;
+    }
+
+    std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+    HullSupport support(*g_ConvexHull);
+    printTimedCase("support/build", start, support.m_Points.size());
+
+    // Random directions, and a slowly rotating one
+    std::mt19937 rng(11);
+    std::normal_distribution<double> normal;
+    uint nbDirections(1000000);
+    std::vector<Vector> randomDirections(nbDirections);
+    std::vector<Vector> coherentDirections(nbDirections);
+    for (uint i = 0; i < nbDirections; ++i) {
+        randomDirections[i] = Vector(normal(rng), normal(rng), normal(rng));
+        double angle(i * 1e-4);
+        coherentDirections[i] = Vector(cos(angle), sin(angle), 0.3 * sin(3 * angle));
+    }
+    std::vector<uint> vertices(nbDirections);
+
+    start = std::chrono::steady_clock::now();
+    support.support(randomDirections.data(), nbDirections, vertices.data());
+    printTimedCase("support/1M random", start, support.m_Levels.size());
+
+    start = std::chrono::steady_clock::now();
+    support.support(coherentDirections.data(), nbDirections, vertices.data());
+    printTimedCase("support/1M coherent", start, support.m_Levels.size());
+
+    // Reference: scan every vertex, for a few queries
+    uint nbScans(nbDirections / 100);
+    uint nbWrong(0);
+    start = std::chrono::steady_clock::now();
+    for (uint i = 0; i < nbScans; ++i) {
+        double best(-std::numeric_limits<double>::max());
+        for (const Point& pt : support.m_Points) {
+            best = (std::max)(best, dot(randomDirections[i], pt));
+        }
+        nbWrong += dot(randomDirections[i], support.m_Points[support.support(randomDirections[i])]) < best ? 1 : 0;
+    }
+    printTimedCase("support/10k scans (wrong)", start, nbWrong);
+}
+
+// Random rotation from a uniformly distributed unit quaternion
+void randomRotation(std::mt19937& io_Rng, double* o_Rotation)
+{
+    std::normal_distribution<double> normal;
+    double q[4];
+    double length(0);
+    for (double& coord : q) {
+        coord = normal(io_Rng);
+        length += coord * coord;
+    }
+    length = sqrt(length);
+    double w(q[0] / length), x(q[1] / length), y(q[2] / length), z(q[3] / length);
+    double rotation[9] = {1 - 2 * (y * y + z * z), 2 * (x * y - w * z), 2 * (x * z + w * y),
+                          2 * (x * y + w * z), 1 - 2 * (x * x + z * z), 2 * (y * z - w * x),
+                          2 * (x * z - w * y), 2 * (y * z + w * x), 1 - 2 * (x * x + y * y)};
+    memcpy(o_Rotation, rotation, sizeof(rotation));
+}
+
+void benchCollision()
+{
+    if (std::string("collision/").find(g_Filter) == std::string::npos && g_Filter.find("collision/") != 0) {
+        return;
+    }
+
+    g_Pts = g_InputPts;
+    g_Engine = TRIANGLE_MESH;
+    g_UseFloat = false;
+    g_GridStep = 0;
+    g_CoplanarMergeAngle = -1;
+    compute3DConvexHull();
+    if (!g_ConvexHull) {
+        return;
+    }
+
+    // Randomly placed copies of the hull, about a third of the pairs overlap
+    HullSupport support(*g_ConvexHull);
+    HullClassifier bounds(*g_ConvexHull);
+    double size((bounds.m_Max - bounds.m_Min).norm());
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<double> position(0, 2 * size);
+    std::vector<HullInstance> instances(1000, HullInstance(&support));
+    for (HullInstance& instance : instances) {
+        randomRotation(rng, instance.m_Rotation);
+        instance.m_Translation = Vector(position(rng), position(rng), position(rng));
+    }
+    std::vector<std::pair<uint, uint>> pairs;
+    for (uint i = 0; i < 100000; ++i) {
+        uint a(rng() % instances.size());
+        uint b((a + 1 + rng() % (instances.size() - 1)) % instances.size());
+        pairs.emplace_back(a, b);
+    }
+
+    std::vector<ProximityCache> caches;
+    std::vector<char> overlapping;
+    std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+    overlaps(instances, pairs, caches, overlapping);
+    printTimedCase("collision/100k overlaps cold", start,
+                   std::count(overlapping.begin(), overlapping.end(), 1));
+
+    // Small motion, then the same queries starting from the cached axes
+    for (HullInstance& instance : instances) {
+        instance.m_Translation += Vector(1e-3, -2e-3, 1e-3) * size;
+    }
+    start = std::chrono::steady_clock::now();
+    overlaps(instances, pairs, caches, overlapping);
+    printTimedCase("collision/100k overlaps warm", start,
+                   std::count(overlapping.begin(), overlapping.end(), 1));
+
+    std::vector<ProximityResult> results;
+    caches.assign(pairs.size(), ProximityCache());
+    start = std::chrono::steady_clock::now();
+    computeProximities(instances, pairs, caches, results);
+    printTimedCase("collision/100k distances cold", start, pairs.size());
+
+    start = std::chrono::steady_clock::now();
+    computeProximities(instances, pairs, caches, results);
+    printTimedCase("collision/100k distances warm", start, pairs.size());
+
+    // Check a few answers: separated pairs against the gap along the axis and
+    // the distance between the closest points, overlapping ones by moving B
+    // just out of contact
+    uint nbWrong(0);
+    start = std::chrono::steady_clock::now();
+    for (uint i = 0; i < 1000; ++i) {
+        const ProximityResult& result(results[i]);
+        const HullInstance& a(instances[pairs[i].first]);
+        HullInstance b(instances[pairs[i].second]);
+        uint hintA(0), hintB(0);
+        if (!result.m_IsOverlapping) {
+            double gap(dot(result.m_Axis, b.support(-result.m_Axis, hintB)) -
+                       dot(result.m_Axis, a.support(result.m_Axis, hintA)));
+            double span((result.m_PointB - result.m_PointA).norm());
+            nbWrong += fabs(gap - result.m_Distance) > 1e-6 * size ||
+                       fabs(span - result.m_Distance) > 1e-6 * size ? 1 : 0;
+        }
+        else {
+            b.m_Translation += result.m_Axis * (1e-3 * size - result.m_Distance);
+            ProximityCache cache;
+            ProximityResult moved(computeProximity(a, b, cache));
+            nbWrong += moved.m_IsOverlapping || fabs(moved.m_Distance - 1e-3 * size) > 1e-6 * size ? 1 : 0;
+        }
+    }
+    printTimedCase("collision/1k checks (wrong)", start, nbWrong);
+}
+
+void benchRays()
+{
+    if (std::string("ray/").find(g_Filter) == std::string::npos && g_Filter.find("ray/") != 0) {
+        return;
+    }
+
+    g_Pts = g_InputPts;
+    g_Engine = TRIANGLE_MESH;
+    g_UseFloat = false;
+    g_GridStep = 0;
+    g_CoplanarMergeAngle = -1;
+    compute3DConvexHull();
+    if (!g_ConvexHull) {
+        return;
+    }
+
+    std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+    HullRayCaster caster(*g_ConvexHull);
+    printTimedCase("ray/build", start, caster.m_Nodes.size());
+
+    // A 1000x1000 camera looking at the hull, and rays between random points
+    // of a sphere around it
+    HullClassifier bounds(*g_ConvexHull);
+    Point center(bounds.m_Min + (bounds.m_Max - bounds.m_Min) * 0.5);
+    double radius((bounds.m_Max - bounds.m_Min).norm());
+    uint resolution(1000);
+    std::vector<Ray> cameraRays(resolution * resolution);
+    for (uint row = 0; row < resolution; ++row) {
+        for (uint column = 0; column < resolution; ++column) {
+            Ray& ray(cameraRays[row * resolution + column]);
+            ray.m_Origin = center + Vector(0, 0, 2 * radius);
+            ray.m_Direction = Vector((column + 0.5) / resolution - 0.5, (row + 0.5) / resolution - 0.5, -1);
+        }
+    }
+    std::mt19937 rng(17);
+    std::normal_distribution<double> normal;
+    std::vector<Ray> randomRays(cameraRays.size());
+    for (Ray& ray : randomRays) {
+        Vector from(normal(rng), normal(rng), normal(rng));
+        Vector to(normal(rng), normal(rng), normal(rng));
+        ray.m_Origin = center + from.normalize() * radius;
+        ray.m_Direction = center + to.normalize() * radius * 0.5 - ray.m_Origin;
+    }
+    std::vector<RayHit> hits(cameraRays.size());
+
+    start = std::chrono::steady_clock::now();
+    caster.cast(cameraRays.data(), cameraRays.size(), hits.data());
+    printTimedCase("ray/1M camera (hits)", start, std::count_if(hits.begin(), hits.end(), [](const RayHit& i_Hit) {
+        return i_Hit.m_EntryFacet != RAY_MISS;
+    }));
+
+    start = std::chrono::steady_clock::now();
+    caster.cast(randomRays.data(), randomRays.size(), hits.data());
+    printTimedCase("ray/1M random (hits)", start, std::count_if(hits.begin(), hits.end(), [](const RayHit& i_Hit) {
+        return i_Hit.m_EntryFacet != RAY_MISS;
+    }));
+
+    // Reference: clip the line by every facet plane, for a few rays
+    auto countWrongHits = [&bounds](const std::vector<Ray>& i_Rays, const std::vector<RayHit>& i_Hits, uint i_NbRays) {
+        uint nbWrong(0);
+        for (uint i = 0; i < i_NbRays; ++i) {
+            const Ray& ray(i_Rays[i]);
+            double entry(-std::numeric_limits<double>::max());
+            double exit(std::numeric_limits<double>::max());
+            for (uint f = 0; f < bounds.m_NbFacets; ++f) {
+                Vector facetNormal(bounds.m_NormalsX[f], bounds.m_NormalsY[f], bounds.m_NormalsZ[f]);
+                double along(dot(facetNormal, ray.m_Direction));
+                double distance(-(dot(facetNormal, ray.m_Origin) + bounds.m_Offsets[f]) / along);
+                if (along < 0) {
+                    entry = (std::max)(entry, distance);
+                } else if (along > 0) {
+                    exit = (std::min)(exit, distance);
+                }
+            }
+            bool isHit(i_Hits[i].m_EntryFacet != RAY_MISS);
+            bool isReferenceHit(entry < exit);
+            if (isHit != isReferenceHit) {
+                nbWrong += fabs(exit - entry) > 1e-6 ? 1 : 0;
+            } else if (isHit) {
+                nbWrong += fabs(i_Hits[i].m_EntryDistance - entry) > 1e-6 || fabs(i_Hits[i].m_ExitDistance - exit) > 1e-6 ? 1 : 0;
+            }
+        }
+        return nbWrong;
+    };
+    start = std::chrono::steady_clock::now();
+    printTimedCase("ray/10k clipped (wrong)", start, countWrongHits(randomRays, hits, randomRays.size() / 100));
+
+    // Axis-aligned rays from hull vertices: their origins lie on the bounds of
+    // BVH nodes along the axes they don't move on
+    std::vector<Ray> axisRays;
+    for (const sptr<Facet>& facet : g_ConvexHull->m_Facets) {
+        if (facet && axisRays.size() < 12000) {
+            for (int axis = 0; axis < 3; ++axis) {
+                for (double sign : { -1.0, 1.0 }) {
+                    Ray ray;
+                    ray.m_Origin = *facet->m_AnEdge->m_Origin;
+                    ray.m_Direction = Vector(0, 0, 0);
+                    ray.m_Direction[axis] = sign;
+                    axisRays.push_back(ray);
+                }
+            }
+        }
+    }
+    hits.resize(axisRays.size());
+    caster.cast(axisRays.data(), axisRays.size(), hits.data());
+    start = std::chrono::steady_clock::now();
+    printTimedCase("ray/axis-aligned (wrong)", start, countWrongHits(axisRays, hits, axisRays.size()));
+}
+
+void benchMassProperties()
+{
+    if (std::string("mass/").find(g_Filter) == std::string::npos && g_Filter.find("mass/") != 0) {
+        return;
+    }
+
+    std::vector<Point> pts;
+    for (const sPoint& pt : g_InputPts) {
+        pts.push_back(*pt);
+    }
+    TriangleMeshHull hull(pts.data(), pts.size());
+    if (!hull.compute()) {
+        return;
+    }
+    DCEL3D dcel(hull.m_Mesh, g_InputPts);
+
+    std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+    MassProperties compact(computeMassProperties(hull.m_Mesh, pts.data()));
+    printTimedCase("mass/compact facets", start, hull.m_Mesh.nbFacets());
+
+    start = std::chrono::steady_clock::now();
+    MassProperties walked(computeMassProperties(dcel));
+    printTimedCase("mass/DCEL facets", start, hull.m_Mesh.nbFacets());
+
+    // Both sum the same triangles in a different order
+    double values[2][14];
+    for (int i = 0; i < 2; ++i) {
+        const MassProperties& properties(i == 0 ? compact : walked);
+        values[i][0] = properties.m_Volume;
+        values[i][1] = properties.m_Area;
+        for (int axis = 0; axis < 3; ++axis) {
+            values[i][2 + axis] = properties.m_Centroid[axis];
+        }
+        for (int j = 0; j < 9; ++j) {
+            values[i][5 + j] = properties.m_Inertia[j];
+        }
+    }
+    start = std::chrono::steady_clock::now();
+    uint nbMismatches(0);
+    double scale(fabs(values[0][0]) + fabs(values[0][1]));
+    for (int j = 0; j < 14; ++j) {
+        nbMismatches += fabs(values[0][j] - values[1][j]) > 1e-12 * (fabs(values[0][j]) + scale) ? 1 : 0;
+    }
+    printTimedCase("mass/mismatches", start, nbMismatches);
+}
+
+void benchOrientedBoxes()
+{
+    if (std::string("obb/").find(g_Filter) == std::string::npos && g_Filter.find("obb/") != 0) {
+        return;
+    }
+
+    g_Pts = g_InputPts;
+    g_Engine = TRIANGLE_MESH;
+    g_UseFloat = false;
+    g_GridStep = 0;
+    g_CoplanarMergeAngle = -1;
+    compute3DConvexHull();
+    if (!g_ConvexHull) {
+        return;
+    }
+
+    // Volumes are shown relative to the face and edge heuristic, in thousandths
+    std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+    HullBoxFitter fitter(*g_ConvexHull);
+    printTimedCase("obb/build", start, fitter.m_X.size());
+
+    start = std::chrono::steady_clock::now();
+    double minimumVolume(fitter.computeMinimumBox().volume());
+    printTimedCase("obb/faces and edges (volume)", start, 1000);
+
+    // Previous approach: extents of every input point along the principal
+    // axes of the cloud
+    start = std::chrono::steady_clock::now();
+    FlatnessInfo info(analyzeFlatness(g_InputPts, 0));
+    double volume(1);
+    for (const Vector& axis : info.m_Axes) {
+        double low(std::numeric_limits<double>::max());
+        double high(-std::numeric_limits<double>::max());
+        for (const sPoint& pt : g_InputPts) {
+            low = (std::min)(low, dot(axis, *pt));
+            high = (std::max)(high, dot(axis, *pt));
+        }
+        volume *= high - low;
+    }
+    printTimedCase("obb/point cloud PCA (volume)", start, uint(1000 * volume / minimumVolume + 0.5));
+
+    for (uint nbDirections : {0, 16, 64, 256}) {
+        start = std::chrono::steady_clock::now();
+        volume = fitter.computeApproximateBox(nbDirections).volume();
+        printTimedCase("obb/approx " + std::to_string(nbDirections) + " dirs (volume)", start,
+                       uint(1000 * volume / minimumVolume + 0.5));
+    }
+}
+
+void benchEpsilonKernel()
+{
+    runCase("kernel/exact", []() {
+        g_Engine = TRIANGLE_MESH;
+    });
+
+    for (double epsilon : {1e-2, 1e-3}) {
+        std::string name("kernel/" + std::to_string(epsilon).substr(0, 5));
+        runCase(name, [&]() {
+            g_Engine = TRIANGLE_MESH;
+            g_KernelEpsilon = epsilon;
+        });
+        if (name.find(g_Filter) == std::string::npos || !g_ConvexHull) {
+            continue;
+        }
+
+        // Largest distance of input points outside the approximate hull, in
+        // millionths of the bounding box diagonal, for 1000 of them. The bound is
+        // a fraction of the diameter, which is at most the diagonal.
+        std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+        Point min(*g_InputPts[0]), max(*g_InputPts[0]);
+        for (const sPoint& pt : g_InputPts) {
+            for (int axis = 0; axis < 3; ++axis) {
+                min[axis] = (std::min)(min[axis], (*pt)[axis]);
+                max[axis] = (std::max)(max[axis], (*pt)[axis]);
+            }
+        }
+        std::vector<Vector> normals;
+        std::vector<double> offsets;
+        for (const sptr<Facet>& facet : g_ConvexHull->m_Facets) {
+            if (facet) {
+                normals.push_back(facet->m_Normal.normalize());
+                offsets.push_back(dot(normals.back(), *facet->m_AnEdge->m_Origin));
+            }
+        }
+        uint step((std::max)(1u, uint(g_InputPts.size() / 1000)));
+        double error(0);
+        for (uint i = 0; i < g_InputPts.size(); i += step) {
+            double distance(-std::numeric_limits<double>::max());
+            for (uint j = 0; j < normals.size(); ++j) {
+                distance = (std::max)(distance, dot(normals[j], *g_InputPts[i]) - offsets[j]);
+            }
+            error = (std::max)(error, distance);
+        }
+        printTimedCase(name + " (error)", start, uint(1e6 * error / (max - min).norm() + 0.5));
+        printTimedCase(name + " (bound)", start, uint(1e6 * g_KernelBound + 0.5));
+    }
+}
+
+void benchFreeze()
+{
+    if (std::string("freeze/").find(g_Filter) == std::string::npos && g_Filter.find("freeze/") != 0) {
+        return;
+    }
+
+    g_Pts = g_InputPts;
+    g_Engine = TRIANGLE_MESH;
+    g_UseFloat = false;
+    g_GridStep = 0;
+    g_CoplanarMergeAngle = -1;
+    compute3DConvexHull();
+    if (!g_ConvexHull) {
+        return;
+    }
+    HullClassifier classifier(*g_ConvexHull, 0);
+
+    std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+    freezeConvexHull();
+    printTimedCase("freeze/freeze", start, g_FrozenHull->m_NbVertices);
+    printTimedCase("freeze/bytes per vertex", start, 
+                   uint(g_FrozenHull->memoryUsage() / (std::max)(1u, g_FrozenHull->m_NbVertices)));
+
+    // Queries over the enlarged bounding box, each tested against every
+    // plane, so fewer of them on large hulls
+    Vector margin((classifier.m_Max - classifier.m_Min) * 0.1);
+    Point low(classifier.m_Min - margin);
+    Point high(classifier.m_Max + margin);
+    std::mt19937 rng(7);
+    std::vector<Point> queries((std::min)(1000000u, (std::max)(1000u, uint(1e9 / g_FrozenHull->m_NbFacets))));
+    for (Point& query : queries) {
+        for (int axis = 0; axis < 3; ++axis) {
+            query[axis] = std::uniform_real_distribution<double>(low[axis], high[axis])(rng);
+        }
+    }
+
+    // Every thread reads the same frozen hull
+    sptr<const FrozenHull> hull(g_FrozenHull);
+    std::vector<double> distances(queries.size());
+    start = std::chrono::steady_clock::now();
+    parallelFor(0, queries.size(), [&](uint, uint i_Begin, uint i_End) {
+        for (uint i = i_Begin; i < i_End; ++i) {
+            distances[i] = hull->maxSignedDistance(queries[i]);
+        }
+    });
+    uint nbOutside(std::count_if(distances.begin(), distances.end(), [](double i_Distance) { 
+        return i_Distance > 0; 
+    }));
+    printTimedCase("freeze/shared readers (outside)", start, nbOutside);
+
+    // Against the double planes, away from the float rounding of the boundary
+    start = std::chrono::steady_clock::now();
+    double tolerance(1e-6 * (high - low).norm());
+    uint nbMismatches(0);
+    for (uint i = 0; i < queries.size(); ++i) {
+        if (fabs(distances[i]) > tolerance && (distances[i] > 0) != (classifier.classify(queries[i]) == OUTSIDE)) {
+            ++nbMismatches;
+        }
+    }
+    printTimedCase("freeze/mismatches", start, nbMismatches);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        std::cerr << "Expected a vertex list file path or sphere:N / cube:N" << std::endl;
+        return 1;
+    }
+
+    // Read or generate input
+    std::string input(argv[1]);
+    size_t colon(input.find(':'));
+    if (colon != std::string::npos) {
+        generatePoints(input.substr(0, colon), atoi(input.c_str() + colon + 1));
+    } else {
+        readVertexFile(argv[1]);
+    }
+    if (argc > 2) {
+        g_Filter = argv[2];
+    }
+
+    g_ShowProgress = false;
+    std::cout << g_InputPts.size() << " points, " << nbThreads() << " threads" << std::endl;
+    printHeader();
+
+    benchInsertionOrders();
+    benchParallelHorizon();
+    benchEngines();
+    benchValidity();
+    benchWriters();
+    benchQueries();
+    benchSupport();
+    benchCollision();
+    benchRays();
+    benchMassProperties();
+    benchOrientedBoxes();
+    benchEpsilonKernel();
+    benchFreeze();
+
+    return 0;
+}
\ No newline at end of file
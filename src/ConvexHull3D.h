@@ -2,32 +2,212 @@
 #define __ConvexHull3D__
 
 #include <algorithm>
+#include <chrono>
 #include <ctime>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <list>
 #include <random>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "DCEL3D.h"
+#include "Deduplication.h"
+#include "Degeneracy.h"
+#include "EpsilonKernel.h"
+#include "FrozenHull.h"
+#include "HullClassifier.h"
+#include "InputStatistics.h"
+#include "MassProperties.h"
+#include "OutputSensitiveHull.h"
+#include "Parallel.h"
 #include "Point.h"
+#include "SpaceFillingCurve.h"
+#include "TriangleMeshHull.h"
 
 std::vector<sPoint> g_Pts;
-int*                g_Index;
+int*                g_Index = NULL;
 sptr<DCEL3D>        g_ConvexHull;
-std::set<uint>*     g_FacetsVisibleByPt;
+std::set<uint>*     g_FacetsVisibleByPt = NULL;
 
-bool areCollinear(sPoint i_A, sPoint i_B, sPoint i_C)
+// Duplicate elimination (points closer than the tolerance on the snapping
+// grid are merged). Maps each original point index to its index in g_Pts.
+bool                g_RemoveDuplicates = false;
+double              g_SnapTolerance = 0.0;
+std::vector<uint>   g_RepresentativeOf;
+
+// Insertion order. BRIO (biased randomized insertion order) inserts points in
+// random rounds of doubling size, each round being sorted along a Morton curve
+// so that consecutive insertions touch nearby parts of the hull. The first
+// round (up to g_BRIOMinRoundSize points) stays in random order: sorted, it
+// builds a hull of one corner of the input that every other point conflicts
+// with.
+enum InsertionOrder { RANDOM_ORDER, BRIO_ORDER };
+InsertionOrder      g_InsertionOrder = RANDOM_ORDER;
+uint                g_BRIOMinRoundSize = 1024;
+
+// Round points to float for the triangle mesh engine, whose copy of the points
+// is then half the size (predicates still evaluate in double). The input is
+// replaced by the rounded points, which the hull is exact for.
+bool                g_UseFloat = false;
+
+// When positive, the triangle mesh engine snaps points on an integer grid of
+// that step and uses exact integer predicates (no epsilon)
+double              g_GridStep = 0.0;
+
+// When positive, the hull is only built on an epsilon-kernel of the points:
+// every point is then within g_KernelEpsilon times the diameter of the input
+// from the hull. g_KernelBound receives the error actually guaranteed.
+double              g_KernelEpsilon = 0.0;
+double              g_KernelBound = 0.0;
+
+// Input that lies within this fraction of its bounding box diagonal of a line
+// or plane skips the 3D engines. Its hull is then g_DegenerateHull and
+// g_ConvexHull is NULL.
+double              g_FlatnessTolerance = 1e-9;
+DegenerateHull      g_DegenerateHull;
+
+// When non-negative, adjacent facets whose normals differ by less than this
+// angle (radians) are merged into polygons once the hull is built, if their
+// vertices are within g_CoplanarMergeDistance times the bounding box diagonal
+// of a common plane. A negative distance stands for the sine of the angle,
+// which is as far as facets bending by the angle across the hull can get.
+double              g_CoplanarMergeAngle = -1;
+double              g_CoplanarMergeDistance = -1;
+
+// Compute volume, area, centroid and inertia of the hull once it is built.
+// The triangle mesh and output-sensitive engines sum their compact facet array
+// before converting it to a DCEL, other engines sum the facets of the finished
+// DCEL.
+bool                g_ComputeMassProperties = false;
+MassProperties      g_MassProperties;
+
+// One PointMembership per input point (before duplicate removal): hull vertex,
+// on the boundary without being a vertex, or strictly inside. The triangle
+// mesh and DCEL engines keep it up to date while inserting points; with the
+// output-sensitive engine, points near the boundary are tested against the
+// finished hull. A point is on a facet when within g_MembershipTolerance of
+// its plane, the rounding error bound of the triangle mesh engine's
+// predicates (see GeometryTraits::computeTolerance). Points of flat input are
+// all on its hull. Points merged into a hull vertex are on the hull. Not
+// available with an epsilon-kernel, which leaves points out of the hull.
+bool                       g_ComputeMembership = false;
+std::vector<unsigned char> g_Membership;
+double                     g_MembershipTolerance = 0;
+
+// Input index of the points inserted by the DCEL engines, to update their
+// membership when they stop being vertices
+std::unordered_map<const Point*, uint> g_IndexOfVertex;
+
+// Read-only hull for query serving, once freezeConvexHull has released the
+// DCEL and everything the engines kept for construction
+sptr<const FrozenHull> g_FrozenHull;
+
+// Print progress messages while building the hull
+bool                g_ShowProgress = true;
+
+// Progressive construction: beginConvexHull builds the initial tetrahedron
+// (or the whole hull for engines that are not incremental), then each
+// advanceConvexHull call inserts points for a bounded time. The hull is valid
+// for the points inserted so far between calls. beginConvexHull is not bounded
+// (the viewer runs it on a worker thread).
+uint                g_NbInsertedPts = 0;
+uint                g_NbPtsToInsert = 0;
+
+// Conflict bookkeeping. The conflict graph stores every facet visible by every
+// point, while the low-memory mode only stores one conflicting facet per point
+// and finds the others by a BFS over the DCEL at insertion time. The history
+// DAG mode stores no conflicts at all: each point finds a visible facet by
+// descending the DAG of replaced facets when its turn comes. The triangle mesh
+// mode builds a compact triangulated hull (see TriangleMeshHull) that is then
+// converted to a DCEL. The output-sensitive mode wraps the hulls of groups of
+// points computed by the triangle mesh engine (see OutputSensitiveHull).
+enum Engine { CONFLICT_GRAPH, LOW_MEMORY, HISTORY_DAG, TRIANGLE_MESH, OUTPUT_SENSITIVE };
+Engine              g_Engine = CONFLICT_GRAPH;
+
+// Pick the engine, duplicate removal and number of threads (at most the
+// current one, for this build only) from a random sample of the input.
+// g_InputStatistics receives what the sample showed.
+bool                g_AutoSelect = false;
+InputStatistics     g_InputStatistics;
+
+#define AUTO_SAMPLE_SIZE          4096
+#define AUTO_MIN_PTS_PER_THREAD   65536
+#define AUTO_MAX_DUPLICATE_RATE   0.01     // Above this, duplicates are removed
+#define AUTO_MAX_HULL_RATIO       0.01     // Below this, the hull is small
+#define AUTO_MIN_THICKNESS        1e-3     // Below this, the input is a slab
+
+#define NO_CONFLICT uint(-1)
+uint*               g_ConflictOfPt = NULL;
+
+// Facets visible by (stamped with the epoch of) the point being inserted,
+// facets created by its insertion and facets just outside its horizon
+uint                     g_Epoch = 0;
+std::vector<sptr<Facet>> g_VisibleFacets;
+std::vector<sptr<Facet>> g_NewFacets;
+std::vector<sptr<Facet>> g_HorizonFacets;
+
+// For each new facet, the deleted facet and the remaining facet that share its
+// horizon edge (its conflicts can only come from theirs)
+std::vector<std::pair<sptr<Facet>, sptr<Facet>>> g_ParentsOfNewFacets;
+
+// Minimum number of new facets for conflicts to be redistributed in parallel
+uint                     g_ParallelHorizonThreshold = 128;
+
+void removeDuplicatePoints()
+{
+    std::vector<uint> representatives(findRepresentatives(g_Pts, g_SnapTolerance));
+
+    // Keep the first point of each cell and remap the others to it
+    std::vector<sPoint> uniquePts;
+    g_RepresentativeOf.resize(g_Pts.size());
+    for (uint i = 0; i < g_Pts.size(); ++i) {
+        if (representatives[i] == i) {
+            g_RepresentativeOf[i] = uniquePts.size();
+            uniquePts.push_back(g_Pts[i]);
+        } else {
+            g_RepresentativeOf[i] = g_RepresentativeOf[representatives[i]];
+        }
+    }
+
+    if (g_ShowProgress) {
+        std::cout << "Removed " << g_Pts.size() - uniquePts.size() << " duplicate points" << std::endl;
+    }
+    g_Pts.swap(uniquePts);
+}
+
+void reduceToEpsilonKernel()
 {
-    return fabs(i_A->m_x * (i_B->m_y - i_C->m_y) +
-                i_B->m_x * (i_C->m_y - i_A->m_y) +
-                i_C->m_x * (i_A->m_y - i_B->m_y)) < EPSILON;
+    std::vector<uint> kernel(computeEpsilonKernel(g_Pts, g_KernelEpsilon, g_KernelBound));
+
+    std::vector<sPoint> kernelPts(kernel.size());
+    for (uint i = 0; i < kernel.size(); ++i) {
+        kernelPts[i] = g_Pts[kernel[i]];
+    }
+
+    if (g_ShowProgress) {
+        std::cout << "Epsilon-kernel: " << g_Pts.size() << " -> " << kernelPts.size()
+                  << " points (error <= " << g_KernelBound << " of the diameter)" << std::endl;
+    }
+    g_Pts.swap(kernelPts);
 }
 
-bool areCoplanar(sPoint i_A, sPoint i_B, sPoint i_C, sPoint i_D)
+template <typename Distance>
+uint findFarthestPoint(Distance i_Distance)
 {
-    return fabs(dot(*i_C - *i_A, cross(*i_B - *i_A, *i_D - *i_C))) < EPSILON;
+    uint farthest(0);
+    double maxDist(-1);
+    for (uint i = 0; i < g_Pts.size(); ++i) {
+        double dist(i_Distance(*g_Pts[i]));
+        if (dist > maxDist) {
+            maxDist = dist;
+            farthest = i;
+        }
+    }
+    return farthest;
 }
 
 void selectInitialTetrahedronVertices(uint& o_P1, uint& o_P2, uint& o_P3, uint& o_P4)
@@ -39,21 +219,51 @@ void selectInitialTetrahedronVertices(uint& o_P1, uint& o_P2, uint& o_P3, uint&
 
     // Randomly pick the first point
     o_P1 = uni(rng);
+    const Point& p1(*g_Pts[o_P1]);
 
-    // Pick a different point
-    do {
-        o_P2 = uni(rng);
-    } while (o_P2 == o_P1);
+    // Pick the point farthest from it
+    o_P2 = findFarthestPoint([&p1](const Point& i_Pt) {
+        return squareDistance(p1, i_Pt);
+    });
 
-    // Pick a point that is not collinear with the 2 others
-    do {
-        o_P3 = uni(rng);
-    } while (areCollinear(g_Pts[o_P1], g_Pts[o_P2], g_Pts[o_P3]));
+    // Pick the point farthest from the line (input is not collinear)
+    Vector dir(*g_Pts[o_P2] - p1);
+    o_P3 = findFarthestPoint([&p1, &dir](const Point& i_Pt) {
+        return cross(dir, i_Pt - p1).squareNorm();
+    });
 
-    // Pick a point that is not coplanar with the 3 others
-    do {
-        o_P4 = uni(rng);
-    } while (areCoplanar(g_Pts[o_P1], g_Pts[o_P2], g_Pts[o_P3], g_Pts[o_P4]));
+    // Pick the point farthest from the plane (input is not coplanar)
+    Vector normal(cross(dir, *g_Pts[o_P3] - p1));
+    o_P4 = findFarthestPoint([&p1, &normal](const Point& i_Pt) {
+        return fabs(dot(normal, i_Pt - p1));
+    });
+}
+
+// i_IsFlat when an engine found the input flat, which it then is even if it
+// is not within g_FlatnessTolerance
+bool handleDegenerateInput(bool i_IsFlat = false)
+{
+    g_DegenerateHull = DegenerateHull();
+    g_DegenerateHull.m_Dimension = 3;
+
+    FlatnessInfo info(analyzeFlatness(g_Pts, g_FlatnessTolerance));
+    if (i_IsFlat) {
+        info.m_Dimension = (std::min)(info.m_Dimension, 2u);
+    }
+    if (info.m_Dimension == 3) {
+        return false;
+    }
+
+    // Hull in the fitted line or plane
+    g_DegenerateHull = computeDegenerateHull(g_Pts, info);
+    g_ConvexHull = NULL;
+
+    if (g_ShowProgress) {
+        const char* names[] = { "a single point", "collinear", "planar" };
+        std::cout << "Input is " << names[info.m_Dimension] << ", hull has " 
+                  << g_DegenerateHull.m_Vertices.size() << " vertices" << std::endl;
+    }
+    return true;
 }
 
 void createRandomPermutationOfIndices(uint i_P1, uint i_P2, uint i_P3, uint i_P4)
@@ -70,11 +280,128 @@ void createRandomPermutationOfIndices(uint i_P1, uint i_P2, uint i_P3, uint i_P4
     }
 
     // Generate a random permutation with the remaining points
-    std::random_shuffle(g_Index, g_Index + g_Pts.size() - 4);
+    std::random_device rd;
+    std::mt19937 rng(rd());
+    std::shuffle(g_Index, g_Index + g_Pts.size() - 4, rng);
+
+    if (g_InsertionOrder != BRIO_ORDER) {
+        return;
+    }
+
+    // Sort each round along the Morton curve. The last round holds half the
+    // points, the one before a quarter, and so on, down to the first round,
+    // which is left random.
+    std::vector<unsigned long long> codes(computeMortonCodes(g_Pts));
+    int* roundEnd(g_Index + g_Pts.size() - 4);
+    while (roundEnd - g_Index > g_BRIOMinRoundSize) {
+        uint roundSize((roundEnd - g_Index + 1) / 2);
+        std::sort(roundEnd - roundSize, roundEnd, [&codes](int i_A, int i_B) {
+            return codes[i_A] < codes[i_B];
+        });
+        roundEnd -= roundSize;
+    }
+}
+
+double computeMembershipTolerance()
+{
+    Point minPt(*g_Pts[0]), maxPt(*g_Pts[0]);
+    for (const sPoint& pt : g_Pts) {
+        for (int axis = 0; axis < 3; ++axis) {
+            minPt[axis] = (std::min)(minPt[axis], (*pt)[axis]);
+            maxPt[axis] = (std::max)(maxPt[axis], (*pt)[axis]);
+        }
+    }
+    return GeometryTraits<double>::computeTolerance(minPt, maxPt);
+}
+
+// Signed offset of the point from the facet plane, as compared to
+// g_MembershipTolerance (the normal is not normalized)
+inline double offsetFromFacet(const Facet& i_Facet, const Point& i_Pt)
+{
+    typedef GeometryTraits<double> Traits;
+    return Traits::computeOffset(i_Facet.m_Normal, i_Pt) - Traits::computeOffset(i_Facet.m_Normal, *i_Facet.m_AnEdge->m_Origin);
+}
+
+// Membership of a point found inside the hull of the DCEL engines, as in
+// TriangleMeshHull: on the boundary if it lies on the plane of one of the
+// facets (which remembers it until it is deleted), interior otherwise
+bool placeInsidePoint(uint i_PtIdx, const std::vector<sptr<Facet>>& i_Facets)
+{
+    for (const sptr<Facet>& facet : i_Facets) {
+        if (fabs(offsetFromFacet(*facet, *g_Pts[i_PtIdx])) <= g_MembershipTolerance) {
+            g_Membership[i_PtIdx] = ON_HULL_FACET;
+            facet->m_PtsOnFacet.push_back(i_PtIdx);
+            return true;
+        }
+    }
+    g_Membership[i_PtIdx] = INTERIOR_POINT;
+    return false;
+}
+
+// During an insertion, a point that was on or outside the deleted facets and
+// is now inside can only be on a new facet or a facet across the horizon
+void placeUncoveredPoint(uint i_PtIdx)
+{
+    if (!placeInsidePoint(i_PtIdx, g_NewFacets)) {
+        placeInsidePoint(i_PtIdx, g_HorizonFacets);
+    }
+}
+
+// Points on a deleted facet and its vertices that are not on the horizon
+// (sorted) are now inside
+void placeRemovedPoints(const sptr<Facet>& i_Facet, const std::vector<const Point*>& i_HorizonVertices)
+{
+    for (uint ptIdx : i_Facet->m_PtsOnFacet) {
+        placeUncoveredPoint(ptIdx);
+    }
+
+    sptr<HalfEdge> edge(i_Facet->m_AnEdge);
+    do {
+        auto vertex(g_IndexOfVertex.find(edge->m_Origin.get()));
+        if (vertex != g_IndexOfVertex.end() && g_Membership[vertex->second] == HULL_VERTEX &&
+            !std::binary_search(i_HorizonVertices.begin(), i_HorizonVertices.end(), edge->m_Origin.get())) {
+            placeUncoveredPoint(vertex->second);
+        }
+        edge = edge->m_Next;
+    } while (edge != i_Facet->m_AnEdge);
+}
+
+void setHullVertex(uint i_PtIdx)
+{
+    g_Membership[i_PtIdx] = HULL_VERTEX;
+    g_IndexOfVertex[g_Pts[i_PtIdx].get()] = i_PtIdx;
 }
 
 void createConflictGraph()
 {
+    // Other modes only remember one facet each point conflicts with
+    if (g_Engine != CONFLICT_GRAPH) {
+        g_ConflictOfPt = new uint[g_Pts.size()];
+        std::fill(g_ConflictOfPt, g_ConflictOfPt + g_Pts.size(), NO_CONFLICT);
+    }
+
+    // Points will be located in the history DAG when inserted
+    if (g_Engine == HISTORY_DAG) {
+        return;
+    }
+
+    // In low-memory mode, each point only remembers one facet it conflicts with
+    if (g_Engine == LOW_MEMORY) {
+        // For each point
+        for (uint i = 0; i < g_Pts.size() - 4; ++i) {
+            // Find the first facet visible from the point
+            uint index(g_Index[i]);
+            for (const sptr<Facet>& facet : g_ConvexHull->m_Facets) {
+                if (facet->isVisibleBy(g_Pts[index])) {
+                    facet->m_Conflicts.emplace(index);
+                    g_ConflictOfPt[index] = facet->m_ID;
+                    break;
+                }
+            }
+        }
+        return;
+    }
+
     // For each point to insert, there is a list of facets with which they are in conflict
     g_FacetsVisibleByPt = new std::set<uint>[g_Pts.size()];
 
@@ -92,16 +419,116 @@ void createConflictGraph()
     }
 }
 
-sptr<HalfEdge> findAnHalfEdgeOfFacetOnHorizon(uint i_FacetID, uint i_PtIdx)
+// When o_FacetOn is given, the descent also goes through facets whose plane
+// holds the point (within g_MembershipTolerance): a point on or above a new
+// facet is on or above one of its parents too, so a point inside the hull
+// reaches the facets it lies on, one of which is returned there.
+sptr<Facet> locateVisibleFacet(sPoint i_Pt, sptr<Facet>* o_FacetOn = NULL)
 {
-    sptr<HalfEdge> halfEdge(g_ConvexHull->m_Facets[i_FacetID]->m_AnEdge);
+    // Depth-first descent from the roots, only through facets visible from the
+    // point. A new facet is visible only if one of its parents (the deleted facet
+    // and the facet across the horizon) is, so we either reach a visible facet
+    // of the current hull or the point is inside.
+    ++g_Epoch;
+    std::vector<sptr<Facet>> toVisit;
+    for (const sptr<Facet>& root : g_ConvexHull->m_InitialFacets) {
+        root->m_Epoch = g_Epoch;
+        toVisit.push_back(root);
+    }
+
+    while (!toVisit.empty()) {
+        sptr<Facet> facet(toVisit.back());
+        toVisit.pop_back();
+
+        bool isVisible(facet->isVisibleBy(i_Pt));
+        if (!isVisible && (!o_FacetOn || fabs(offsetFromFacet(*facet, *i_Pt)) > g_MembershipTolerance)) {
+            continue;
+        }
+        // Facet is still part of the hull
+        if (g_ConvexHull->m_Facets[facet->m_ID]) {
+            if (isVisible) {
+                return facet;
+            }
+            *o_FacetOn = facet;
+        }
+        for (const sptr<Facet>& child : facet->m_Children) {
+            if (child->m_Epoch != g_Epoch) {
+                child->m_Epoch = g_Epoch;
+                toVisit.push_back(child);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+bool hasConflicts(uint i_PtIdx)
+{
+    if (g_Engine == HISTORY_DAG) {
+        sptr<Facet> facetOn;
+        sptr<Facet> facet(locateVisibleFacet(g_Pts[i_PtIdx], g_ComputeMembership ? &facetOn : NULL));
+        g_ConflictOfPt[i_PtIdx] = facet ? facet->m_ID : NO_CONFLICT;
+
+        // Inside points are only located now
+        if (!facet && g_ComputeMembership) {
+            placeInsidePoint(i_PtIdx, facetOn ? std::vector<sptr<Facet>>(1, facetOn) : std::vector<sptr<Facet>>());
+        }
+    }
+    if (g_Engine != CONFLICT_GRAPH) {
+        return g_ConflictOfPt[i_PtIdx] != NO_CONFLICT;
+    }
+    return !g_FacetsVisibleByPt[i_PtIdx].empty();
+}
+
+inline bool isVisibleByInsertedPt(const sptr<Facet>& i_Facet)
+{
+    return i_Facet->m_Epoch == g_Epoch;
+}
+
+void findVisibleFacets(uint i_PtIdx)
+{
+    // Start a new insertion: facets stamped with the new epoch are visible
+    ++g_Epoch;
+    g_VisibleFacets.clear();
+
+    // The conflict graph already knows every visible facet
+    if (g_Engine == CONFLICT_GRAPH) {
+        for (uint facetID : g_FacetsVisibleByPt[i_PtIdx]) {
+            sptr<Facet>& facet(g_ConvexHull->m_Facets[facetID]);
+            facet->m_Epoch = g_Epoch;
+            g_VisibleFacets.push_back(facet);
+        }
+        return;
+    }
+
+    // Otherwise, do a BFS starting from the only known visible facet (the
+    // visible region of a convex polyhedron is connected)
+    sptr<Facet>& firstFacet(g_ConvexHull->m_Facets[g_ConflictOfPt[i_PtIdx]]);
+    firstFacet->m_Epoch = g_Epoch;
+    g_VisibleFacets.push_back(firstFacet);
+
+    for (uint i = 0; i < g_VisibleFacets.size(); ++i) {
+        sptr<HalfEdge> halfEdge(g_VisibleFacets[i]->m_AnEdge);
+        do {
+            sptr<Facet>& neighbor(halfEdge->m_Twin->m_Facet);
+            if (!isVisibleByInsertedPt(neighbor) && neighbor->isVisibleBy(g_Pts[i_PtIdx])) {
+                neighbor->m_Epoch = g_Epoch;
+                g_VisibleFacets.push_back(neighbor);
+            }
+            halfEdge = halfEdge->m_Next;
+        } while (halfEdge != g_VisibleFacets[i]->m_AnEdge);
+    }
+}
+
+sptr<HalfEdge> findAnHalfEdgeOfFacetOnHorizon(const sptr<Facet>& i_Facet)
+{
+    sptr<HalfEdge> halfEdge(i_Facet->m_AnEdge);
     sptr<HalfEdge> firstEdge(halfEdge);
-    std::set<uint>& visibleFacetIDs(g_FacetsVisibleByPt[i_PtIdx]);
 
     // For every half-edge forming the facet
     do {
         // If facet next to that half-edge is not visible, then edge is on the horizon
-        if (visibleFacetIDs.find(halfEdge->m_Twin->m_Facet->m_ID) == visibleFacetIDs.end()) {
+        if (!isVisibleByInsertedPt(halfEdge->m_Twin->m_Facet)) {
             return halfEdge;
         }
         halfEdge = halfEdge->m_Next;
@@ -111,15 +538,14 @@ sptr<HalfEdge> findAnHalfEdgeOfFacetOnHorizon(uint i_FacetID, uint i_PtIdx)
     return NULL;
 }
 
-sptr<HalfEdge> findNextHalfEdgeOnHorizon(sptr<HalfEdge> i_HalfEdge, uint i_PtIdx)
+sptr<HalfEdge> findNextHalfEdgeOnHorizon(sptr<HalfEdge> i_HalfEdge)
 {
     sptr<HalfEdge> nextHalfEdge = i_HalfEdge->m_Next;
-    std::set<uint>& visibleFacetIDs(g_FacetsVisibleByPt[i_PtIdx]);
 
     // For every half-edge sharing the same origin
     do {
         // If facet next to that half-edge is not visible, then edge is on the horizon
-        if (visibleFacetIDs.find(nextHalfEdge->m_Twin->m_Facet->m_ID) == visibleFacetIDs.end()) {
+        if (!isVisibleByInsertedPt(nextHalfEdge->m_Twin->m_Facet)) {
             return nextHalfEdge;
         }
         nextHalfEdge = nextHalfEdge->m_Twin->m_Next;
@@ -147,9 +573,67 @@ void addNewConflicts(sptr<Facet> m_FromFacet, sptr<Facet> m_ToFacet, uint i_Proc
     }
 }
 
+void addNewConflictsInParallel(uint i_ProcessedPt)
+{
+    // Each thread fills the conflict lists of its own new facets
+    parallelFor(0, g_NewFacets.size(), [&](uint, uint i_Begin, uint i_End) {
+        for (uint i = i_Begin; i < i_End; ++i) {
+            const sptr<Facet>& newFacet(g_NewFacets[i]);
+            for (const sptr<Facet>* parent : { &g_ParentsOfNewFacets[i].first,
+                                               &g_ParentsOfNewFacets[i].second }) {
+                for (uint index : (*parent)->m_Conflicts) {
+                    if (index != i_ProcessedPt && newFacet->isVisibleBy(g_Pts[index])) {
+                        newFacet->m_Conflicts.emplace(index);
+                    }
+                }
+            }
+        }
+    });
+
+    // A point can see several new facets, so update the points' side serially
+    for (const sptr<Facet>& newFacet : g_NewFacets) {
+        for (uint index : newFacet->m_Conflicts) {
+            g_FacetsVisibleByPt[index].emplace(newFacet->m_ID);
+        }
+    }
+}
+
+bool addConflictWithFirstVisible(uint i_PtIdx, const std::vector<sptr<Facet>>& i_Facets)
+{
+    for (const sptr<Facet>& facet : i_Facets) {
+        if (facet->isVisibleBy(g_Pts[i_PtIdx])) {
+            facet->m_Conflicts.emplace(i_PtIdx);
+            g_ConflictOfPt[i_PtIdx] = facet->m_ID;
+            return true;
+        }
+    }
+    return false;
+}
+
+void redistributeConflicts(uint i_ProcessedPt)
+{
+    // For each point in conflict with a deleted facet
+    for (const sptr<Facet>& oldFacet : g_VisibleFacets) {
+        for (uint index : oldFacet->m_Conflicts) {
+            if (index == i_ProcessedPt) {
+                continue;
+            }
+            // If the point is still outside, its visible region is connected and
+            // touches the deleted facets, so it contains either a new facet or a
+            // facet just outside the horizon. Otherwise, the point is inside.
+            g_ConflictOfPt[index] = NO_CONFLICT;
+            if (!addConflictWithFirstVisible(index, g_NewFacets) &&
+                !addConflictWithFirstVisible(index, g_HorizonFacets) && g_ComputeMembership) {
+                placeUncoveredPoint(index);
+            }
+        }
+    }
+}
+
 sptr<HalfEdge> addNewFace(uint i_PtIdx, sptr<HalfEdge> i_HalfEdge)
 {
     sptr<HalfEdge> twin(i_HalfEdge->m_Twin);
+    g_HorizonFacets.push_back(twin->m_Facet);
 
     // Check if the face that must be created is coplanar with its adjacent face
     if (twin->m_Facet->isCoplanarWith(g_Pts[i_PtIdx])) {
@@ -167,14 +651,19 @@ sptr<HalfEdge> addNewFace(uint i_PtIdx, sptr<HalfEdge> i_HalfEdge)
         sptr<Facet> newFacet(g_ConvexHull->addFacet(i_HalfEdge->m_Origin, 
                                                     i_HalfEdge->m_Next->m_Origin, 
                                                     g_Pts[i_PtIdx]));
+        g_NewFacets.push_back(newFacet);
+
         // Set twins for new facet
         twin->twinTo(newFacet->m_AnEdge);
 
-        // For each point in conflict with the first facet
-        addNewConflicts(i_HalfEdge->m_Facet, newFacet, i_PtIdx);
-
-        // For each point in conflict with the second facet
-        addNewConflicts(twin->m_Facet, newFacet, i_PtIdx);
+        if (g_Engine == HISTORY_DAG) {
+            // Remember which facets the new facet replaces
+            i_HalfEdge->m_Facet->m_Children.push_back(newFacet);
+            twin->m_Facet->m_Children.push_back(newFacet);
+        } else if (g_Engine == CONFLICT_GRAPH) {
+            // Conflicts are added once the whole cone is built
+            g_ParentsOfNewFacets.emplace_back(i_HalfEdge->m_Facet, twin->m_Facet);
+        }
 
         return newFacet->m_AnEdge->m_Next;
     }
@@ -182,13 +671,16 @@ sptr<HalfEdge> addNewFace(uint i_PtIdx, sptr<HalfEdge> i_HalfEdge)
 
 void insertPointInConvexHull(uint i_PtIdx)
 {
+    // Stamp every facet visible from the point
+    findVisibleFacets(i_PtIdx);
+
     // Find an arbitrary edge that is on the horizon
     sptr<HalfEdge> startEdge;
 
     // For each visible facet
-    for (uint facetID : g_FacetsVisibleByPt[i_PtIdx]) {
+    for (const sptr<Facet>& facet : g_VisibleFacets) {
         // Find an half-edge that is on the horizon
-        startEdge = findAnHalfEdgeOfFacetOnHorizon(facetID, i_PtIdx);
+        startEdge = findAnHalfEdgeOfFacetOnHorizon(facet);
         // If we found one
         if (startEdge) {
             break;
@@ -202,7 +694,15 @@ void insertPointInConvexHull(uint i_PtIdx)
     sptr<HalfEdge> halfEdge(startEdge);
     sptr<HalfEdge> waiting4ATwin;
     sptr<HalfEdge> lastToTwin;
+    g_NewFacets.clear();
+    g_HorizonFacets.clear();
+    g_ParentsOfNewFacets.clear();
+    std::vector<const Point*> horizonVertices;
     do {
+        if (g_ComputeMembership) {
+            horizonVertices.push_back(halfEdge->m_Origin.get());
+        }
+
         // Add new face to convex hull
         sptr<HalfEdge> twinMe(addNewFace(i_PtIdx, halfEdge));
 
@@ -215,27 +715,393 @@ void insertPointInConvexHull(uint i_PtIdx)
         waiting4ATwin = twinMe;
 
         // Find next edge on horizon
-        halfEdge = findNextHalfEdgeOnHorizon(halfEdge, i_PtIdx);
+        halfEdge = findNextHalfEdgeOnHorizon(halfEdge);
     } while (halfEdge != startEdge);
 
     // Connect last facet with first one
     lastToTwin->m_Next->twinTo(waiting4ATwin);
 
-    // Delete arcs incident to deleted facets
-    for (uint facetID : g_FacetsVisibleByPt[i_PtIdx]) {
-        for (uint ptIndex : g_ConvexHull->m_Facets[facetID]->m_Conflicts) {
-            if (i_PtIdx != ptIndex) {
-                g_FacetsVisibleByPt[ptIndex].erase(facetID);
+    // Give points that saw deleted facets a new conflict
+    if (g_Engine == LOW_MEMORY) {
+        redistributeConflicts(i_PtIdx);
+    } else if (g_Engine == CONFLICT_GRAPH) {
+        if (g_NewFacets.size() >= g_ParallelHorizonThreshold && nbThreads() > 1) {
+            addNewConflictsInParallel(i_PtIdx);
+        } else {
+            for (uint i = 0; i < g_NewFacets.size(); ++i) {
+                // For each point in conflict with the first facet
+                addNewConflicts(g_ParentsOfNewFacets[i].first, g_NewFacets[i], i_PtIdx);
+
+                // For each point in conflict with the second facet
+                addNewConflicts(g_ParentsOfNewFacets[i].second, g_NewFacets[i], i_PtIdx);
             }
         }
-        // Remove the facet from the DCEL (it is still referenced by twins)
-        g_ConvexHull->m_Facets[facetID] = NULL;
+    }
+
+    if (g_ComputeMembership) {
+        setHullVertex(i_PtIdx);
+        std::sort(horizonVertices.begin(), horizonVertices.end());
+    }
+
+    // Delete arcs incident to deleted facets. Points left without any are now
+    // inside.
+    for (const sptr<Facet>& facet : g_VisibleFacets) {
+        if (g_Engine == CONFLICT_GRAPH) {
+            for (uint ptIndex : facet->m_Conflicts) {
+                if (i_PtIdx != ptIndex) {
+                    g_FacetsVisibleByPt[ptIndex].erase(facet->m_ID);
+                    if (g_ComputeMembership && g_FacetsVisibleByPt[ptIndex].empty()) {
+                        placeUncoveredPoint(ptIndex);
+                    }
+                }
+            }
+        }
+        if (g_ComputeMembership) {
+            placeRemovedPoints(facet, horizonVertices);
+        }
+        // Remove the facet from the DCEL and free its half-edges (the
+        // history DAG may still test its plane)
+        g_ConvexHull->m_Facets[facet->m_ID] = NULL;
+        facet->breakCycles();
     }
 }
 
-sptr<DCEL3D> compute3DConvexHull()
+template <typename Scalar>
+sptr<DCEL3D> computeTriangleMeshConvexHull()
+{
+    // The engine wants contiguous points
+    std::vector<TPoint<Scalar>> pts;
+    pts.reserve(g_Pts.size());
+    for (const sPoint& pt : g_Pts) {
+        pts.push_back(TPoint<Scalar>(*pt));
+    }
+
+    // The hull is exact for rounded points, so make the input match them (as
+    // snapPointsToGrid does)
+    if (sizeof(Scalar) < sizeof(double)) {
+        for (uint i = 0; i < g_Pts.size(); ++i) {
+            g_Pts[i] = sPoint(new Point(pts[i]));
+        }
+    }
+
+    if (g_ShowProgress) {
+        std::cout << "Building triangle mesh hull" << std::endl;
+    }
+    TTriangleMeshHull<Scalar> hull(pts.data(), pts.size(), g_ComputeMembership);
+    if (!hull.compute()) {
+        // Flat for the engine (see findInitialTetrahedron)
+        handleDegenerateInput(true);
+        return g_ConvexHull;
+    }
+    if (g_ComputeMassProperties) {
+        g_MassProperties = computeMassProperties(hull.m_Mesh, pts.data());
+    }
+    g_Membership.swap(hull.m_Membership);
+
+    g_ConvexHull = sptr<DCEL3D>(new DCEL3D(hull.m_Mesh, g_Pts));
+    return g_ConvexHull;
+}
+
+bool snapPointsToGrid(std::vector<TPoint<int>>& o_Pts)
+{
+    o_Pts.reserve(g_Pts.size());
+    for (sPoint& pt : g_Pts) {
+        long long x(llround(pt->m_x / g_GridStep));
+        long long y(llround(pt->m_y / g_GridStep));
+        long long z(llround(pt->m_z / g_GridStep));
+        if (std::abs(x) > MAX_GRID_COORD || std::abs(y) > MAX_GRID_COORD || std::abs(z) > MAX_GRID_COORD) {
+            std::cerr << "Grid step " << g_GridStep << " is too small for the input range" << std::endl;
+            return false;
+        }
+        o_Pts.push_back(TPoint<int>(int(x), int(y), int(z)));
+    }
+
+    // The hull is exact for snapped points, so make the input match them
+    for (uint i = 0; i < g_Pts.size(); ++i) {
+        g_Pts[i] = sPoint(new Point(o_Pts[i].m_x * g_GridStep, 
+                                    o_Pts[i].m_y * g_GridStep, 
+                                    o_Pts[i].m_z * g_GridStep));
+    }
+    return true;
+}
+
+sptr<DCEL3D> computeQuantizedConvexHull()
+{
+    std::vector<TPoint<int>> pts;
+    if (!snapPointsToGrid(pts)) {
+        return computeTriangleMeshConvexHull<double>();
+    }
+
+    if (g_ShowProgress) {
+        std::cout << "Building exact triangle mesh hull on a grid of step " << g_GridStep << std::endl;
+    }
+    TTriangleMeshHull<int> hull(pts.data(), pts.size(), g_ComputeMembership);
+    if (!hull.compute()) {
+        // Snapping made the input exactly flat (see areCoplanar)
+        handleDegenerateInput(true);
+        return g_ConvexHull;
+    }
+    if (g_ComputeMassProperties) {
+        g_MassProperties = computeMassProperties(hull.m_Mesh, pts.data(), g_GridStep);
+    }
+    g_Membership.swap(hull.m_Membership);
+
+    g_ConvexHull = sptr<DCEL3D>(new DCEL3D(hull.m_Mesh, g_Pts));
+    return g_ConvexHull;
+}
+
+sptr<DCEL3D> computeOutputSensitiveConvexHull()
+{
+    std::vector<Point> pts;
+    pts.reserve(g_Pts.size());
+    for (const sPoint& pt : g_Pts) {
+        pts.push_back(*pt);
+    }
+
+    if (g_ShowProgress) {
+        std::cout << "Building output-sensitive hull" << std::endl;
+    }
+    OutputSensitiveHull hull(pts.data(), pts.size());
+    bool isBuilt(hull.compute());
+    if (g_ShowProgress) {
+        std::cout << "Hull size guessed " << hull.m_NbGuesses << " times, last groups of "
+                  << hull.m_GroupSize << " points" << std::endl;
+    }
+    if (!isBuilt) {
+        // The hull candidates are flat for the triangle mesh engine
+        handleDegenerateInput(true);
+        return g_ConvexHull;
+    }
+    if (g_ComputeMassProperties) {
+        g_MassProperties = computeMassProperties(hull.m_Mesh, pts.data());
+    }
+
+    g_ConvexHull = sptr<DCEL3D>(new DCEL3D(hull.m_Mesh, g_Pts));
+    return g_ConvexHull;
+}
+
+void simplifyConvexHull()
+{
+    if (!g_ConvexHull || g_CoplanarMergeAngle < 0) {
+        return;
+    }
+
+    uint nbFacets(g_ConvexHull->m_Facets.size());
+    for (const sptr<Facet>& facet : g_ConvexHull->m_Facets) {
+        nbFacets -= facet ? 0 : 1;
+    }
+
+    double maxDistance(g_CoplanarMergeDistance);
+    if (maxDistance < 0) {
+        maxDistance = g_CoplanarMergeAngle < acos(0.0) ? sin(g_CoplanarMergeAngle) : 1.0;
+    }
+
+    uint nbRemovedVertices;
+    uint nbRemovedFacets(g_ConvexHull->mergeCoplanarFacets(g_CoplanarMergeAngle, maxDistance, g_FlatnessTolerance,
+                                                           nbRemovedVertices));
+
+    if (g_ShowProgress) {
+        std::cout << "Merged coplanar facets: " << nbFacets << " -> " << nbFacets - nbRemovedFacets
+                  << " facets, " << nbRemovedVertices << " redundant vertices removed" << std::endl;
+    }
+}
+
+// Location of a point against every facet plane, with the membership
+// tolerance
+PointLocation locateWithMembershipTolerance(const Point& i_Pt)
+{
+    PointLocation location(INSIDE);
+    for (const sptr<Facet>& facet : g_ConvexHull->m_Facets) {
+        if (!facet) {
+            continue;
+        }
+        double offset(offsetFromFacet(*facet, i_Pt));
+        if (offset > g_MembershipTolerance) {
+            return OUTSIDE;
+        }
+        if (offset >= -g_MembershipTolerance) {
+            location = ON_HULL;
+        }
+    }
+    return location;
+}
+
+void computeMembership()
 {
-    std::cout << "Building initial tetrahedron" << std::endl;
+    std::vector<unsigned char> membership;
+    membership.swap(g_Membership);
+    if (!g_ComputeMembership) {
+        return;
+    }
+    if (g_KernelEpsilon > 0) {
+        std::cerr << "Point membership is not available with an epsilon-kernel" << std::endl;
+        return;
+    }
+
+    if (!g_ConvexHull) {
+        // Flat input
+        membership.assign(g_Pts.size(), ON_HULL_FACET);
+        for (uint vertex : g_DegenerateHull.m_Vertices) {
+            membership[vertex] = HULL_VERTEX;
+        }
+    } else if (membership.empty() || g_CoplanarMergeAngle >= 0) {
+        std::unordered_set<const Point*> vertices;
+        for (const sptr<Facet>& facet : g_ConvexHull->m_Facets) {
+            if (!facet) {
+                continue;
+            }
+            sptr<HalfEdge> edge(facet->m_AnEdge);
+            do {
+                vertices.insert(edge->m_Origin.get());
+                edge = edge->m_Next;
+            } while (edge != facet->m_AnEdge);
+        }
+
+        if (membership.empty()) {
+            // Not tracked by the engine (output-sensitive). The classifier
+            // only decides points inside by more than the membership tolerance
+            // of every facet (as a distance), the others are tested against
+            // each facet plane.
+            g_MembershipTolerance = computeMembershipTolerance();
+            double distance(0);
+            for (const sptr<Facet>& facet : g_ConvexHull->m_Facets) {
+                double normalLength(facet ? facet->m_Normal.norm() : 0);
+                if (normalLength > 0) {
+                    distance = (std::max)(distance, g_MembershipTolerance / normalLength);
+                }
+            }
+            membership.resize(g_Pts.size());
+            HullClassifier(*g_ConvexHull, distance).classify(g_Pts, membership.data());
+
+            uint nbOutside(0);
+            for (uint i = 0; i < g_Pts.size(); ++i) {
+                PointLocation location(PointLocation(membership[i]));
+                if (vertices.count(g_Pts[i].get())) {
+                    membership[i] = HULL_VERTEX;
+                    continue;
+                }
+                if (location != INSIDE) {
+                    location = locateWithMembershipTolerance(*g_Pts[i]);
+                }
+                nbOutside += location == OUTSIDE ? 1 : 0;
+                membership[i] = location == INSIDE ? INTERIOR_POINT : ON_HULL_FACET;
+            }
+            if (nbOutside > 0) {
+                std::cerr << nbOutside << " points are outside the hull by more than the rounding tolerance, "
+                          << "reported on its boundary" << std::endl;
+            }
+        } else {
+            // Vertices between merged facets are now on a facet
+            for (uint i = 0; i < g_Pts.size(); ++i) {
+                if (membership[i] == HULL_VERTEX && !vertices.count(g_Pts[i].get())) {
+                    membership[i] = ON_HULL_FACET;
+                }
+            }
+        }
+    }
+
+    // Back to the input before duplicate removal. The first point of each
+    // cell was kept, the others are on it.
+    if (g_RemoveDuplicates) {
+        g_Membership.resize(g_RepresentativeOf.size());
+        std::vector<char> isKept(membership.size(), false);
+        for (uint i = 0; i < g_RepresentativeOf.size(); ++i) {
+            uint representative(g_RepresentativeOf[i]);
+            g_Membership[i] = membership[representative] == HULL_VERTEX && isKept[representative] 
+                            ? (unsigned char)ON_HULL_FACET : membership[representative];
+            isKept[representative] = true;
+        }
+    } else {
+        g_Membership.swap(membership);
+    }
+}
+
+void selectSettings()
+{
+    g_InputStatistics = sampleInput(g_Pts, AUTO_SAMPLE_SIZE, g_SnapTolerance);
+    const InputStatistics& statistics(g_InputStatistics);
+
+    // Threads only pay off with enough points each
+    nbThreads() = (std::max)(1u, (std::min)(nbThreads(), statistics.m_NbPts / AUTO_MIN_PTS_PER_THREAD));
+
+    g_RemoveDuplicates = g_RemoveDuplicates || statistics.m_DuplicateRate > AUTO_MAX_DUPLICATE_RATE;
+
+    // The output-sensitive engine needs a small hull, groups that can be
+    // dropped (they seldom can in a slab) and threads to build them. The DCEL
+    // engines are never picked, the triangle mesh engine is faster on every
+    // benchmark input.
+    bool isSmallHull(statistics.m_EstimatedHullSize < AUTO_MAX_HULL_RATIO * statistics.m_NbPts);
+    bool isSlab(statistics.m_Thickness < AUTO_MIN_THICKNESS);
+    g_Engine = isSmallHull && !isSlab && nbThreads() > 1 ? OUTPUT_SENSITIVE : TRIANGLE_MESH;
+
+    // Log the decision as the options that reproduce it, even without
+    // progress messages
+    std::cout << "Auto: sampled " << statistics.m_SampleSize << " of " << statistics.m_NbPts
+              << " points, hull ratio " << statistics.m_HullRatio << " (growth " << statistics.m_HullGrowth
+              << ", about " << uint(statistics.m_EstimatedHullSize) << " hull vertices), thickness "
+              << statistics.m_Thickness << ", duplicate rate " << statistics.m_DuplicateRate << std::endl;
+    std::cout << "Auto: using " << (g_Engine == OUTPUT_SENSITIVE ? "-chan" : "-trimesh");
+    if (g_RemoveDuplicates) {
+        std::cout << " -dedup " << g_SnapTolerance;
+    }
+    std::cout << " -threads " << nbThreads() << std::endl;
+}
+
+bool beginConvexHull()
+{
+    g_NbInsertedPts = 0;
+    g_NbPtsToInsert = 0;
+    g_MassProperties = MassProperties();
+    g_Membership.clear();
+    g_FrozenHull = NULL;
+
+    // Engine and prefilters from a sample of the input. The engines it picks
+    // finish here, the number of threads it picks is restored on return.
+    ThreadCountScope threadCount;
+    if (g_AutoSelect) {
+        selectSettings();
+    }
+
+    // Merge duplicate and near-duplicate points
+    if (g_RemoveDuplicates) {
+        removeDuplicatePoints();
+    }
+
+    // Keep only the points that matter up to the tolerated error
+    g_KernelBound = 0;
+    if (g_KernelEpsilon > 0) {
+        reduceToEpsilonKernel();
+    }
+
+    // Flat input never enters the 3D engines
+    if (handleDegenerateInput()) {
+        computeMembership();
+        return true;
+    }
+
+    if (g_Engine == TRIANGLE_MESH) {
+        if (g_GridStep > 0) {
+            computeQuantizedConvexHull();
+        } else if (g_UseFloat) {
+            computeTriangleMeshConvexHull<float>();
+        } else {
+            computeTriangleMeshConvexHull<double>();
+        }
+        simplifyConvexHull();
+        computeMembership();
+        return true;
+    }
+
+    if (g_Engine == OUTPUT_SENSITIVE) {
+        computeOutputSensitiveConvexHull();
+        simplifyConvexHull();
+        computeMembership();
+        return true;
+    }
+
+    if (g_ShowProgress) {
+        std::cout << "Building initial tetrahedron" << std::endl;
+    }
 
     // Select points that forms the initial tetrahedron
     uint p1, p2, p3, p4;
@@ -248,21 +1114,90 @@ sptr<DCEL3D> compute3DConvexHull()
     g_ConvexHull = sptr<DCEL3D>(new DCEL3D(g_Pts[p1], g_Pts[p2], g_Pts[p3], g_Pts[p4]));
 
     // Create conflict graph
-    std::cout << "Creating initial conflict graph" << std::endl;
+    if (g_ShowProgress) {
+        std::cout << "Creating initial conflict graph" << std::endl;
+    }
     createConflictGraph();
 
-    // Add each remaining point to the convex hull
-    for (uint i = 0; i < g_Pts.size() - 4; ++i) {
-        printf("\rAdding point %d/%d", i, g_Pts.size() - 4);
-        if (!g_FacetsVisibleByPt[g_Index[i]].empty()) {
-            insertPointInConvexHull(g_Index[i]);
+    // Membership of the tetrahedron vertices and of the points inside it (the
+    // history DAG locates points when their turn comes)
+    if (g_ComputeMembership) {
+        g_MembershipTolerance = computeMembershipTolerance();
+        g_Membership.assign(g_Pts.size(), INTERIOR_POINT);
+        g_IndexOfVertex.clear();
+        for (uint vertex : { p1, p2, p3, p4 }) {
+            setHullVertex(vertex);
+        }
+        for (uint i = 0; i < g_Pts.size() - 4 && g_Engine != HISTORY_DAG; ++i) {
+            if (!hasConflicts(g_Index[i])) {
+                placeInsidePoint(g_Index[i], g_ConvexHull->m_Facets);
+            }
+        }
+    }
+
+    g_NbPtsToInsert = g_Pts.size() - 4;
+    return false;
+}
+
+bool advanceConvexHull(double i_MaxSeconds)
+{
+    auto start(std::chrono::steady_clock::now());
+
+    // Add remaining points to the convex hull until time is up
+    while (g_NbInsertedPts < g_NbPtsToInsert) {
+        if (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() > i_MaxSeconds) {
+            return false;
+        }
+        if (g_ShowProgress) {
+            printf("\rAdding point %d/%d", g_NbInsertedPts, g_NbPtsToInsert);
+        }
+        uint ptIdx(g_Index[g_NbInsertedPts++]);
+        if (hasConflicts(ptIdx)) {
+            insertPointInConvexHull(ptIdx);
         }
     }
 
     // Get rid of those monstrous integers !
     delete[] g_Index;
+    delete[] g_ConflictOfPt;
+    delete[] g_FacetsVisibleByPt;
+    g_Index = NULL;
+    g_ConflictOfPt = NULL;
+    g_FacetsVisibleByPt = NULL;
+    g_NbPtsToInsert = 0;
+    g_NbInsertedPts = 0;
+    std::unordered_map<const Point*, uint>().swap(g_IndexOfVertex);
+
+    if (g_ComputeMassProperties) {
+        g_MassProperties = computeMassProperties(*g_ConvexHull);
+    }
+    simplifyConvexHull();
+    computeMembership();
+    return true;
+}
 
+sptr<DCEL3D> compute3DConvexHull()
+{
+    if (!beginConvexHull()) {
+        advanceConvexHull(std::numeric_limits<double>::infinity());
+    }
     return g_ConvexHull;
 }
 
+// Replaces the built hull by its frozen copy. Flat input has no DCEL to freeze.
+void freezeConvexHull()
+{
+    if (!g_ConvexHull) {
+        return;
+    }
+    g_FrozenHull = sptr<const FrozenHull>(new FrozenHull(*g_ConvexHull));
+
+    // Facets of the last insertion would keep theirs and their neighbors alive
+    std::vector<sptr<Facet>>().swap(g_VisibleFacets);
+    std::vector<sptr<Facet>>().swap(g_NewFacets);
+    std::vector<sptr<Facet>>().swap(g_HorizonFacets);
+    std::vector<std::pair<sptr<Facet>, sptr<Facet>>>().swap(g_ParentsOfNewFacets);
+    g_ConvexHull = NULL;
+}
+
 #endif
\ No newline at end of file
@@ -1,5 +1,9 @@
+#include <algorithm>
+
 #include "DCEL3D.h"
 
+#define NO_REGION uint(-1)
+
 /************************************************************************/
 /*                             HalfEdge                                 */
 /************************************************************************/
@@ -45,13 +49,14 @@ bool HalfEdge::hasExtremities(sPoint i_PtA, sPoint i_PtB)
 /*                               Facet                                  */
 /************************************************************************/
 
-uint Facet::s_LastID = 0;
-
 Facet::Facet(sPoint i_PtA, sPoint i_PtB, sPoint i_PtC, sPoint i_InsideDCEL3D) :
     m_Normal(cross(*i_PtB - *i_PtA, *i_PtC - *i_PtA)),
     m_AnEdge(new HalfEdge(i_PtA)),
-    m_ID(s_LastID++),
-    m_Conflicts()
+    m_ID(0),
+    m_Conflicts(),
+    m_Epoch(0),
+    m_Children(),
+    m_PtsOnFacet()
 {
     // Check if its normal points in the right direction 
     // (away from the center of the DCEL)
@@ -64,6 +69,18 @@ Facet::Facet(sPoint i_PtA, sPoint i_PtB, sPoint i_PtC, sPoint i_InsideDCEL3D) :
     }
 }
 
+Facet::Facet(sPoint i_PtA, sPoint i_PtB, sPoint i_PtC) :
+    m_Normal(cross(*i_PtB - *i_PtA, *i_PtC - *i_PtA)),
+    m_AnEdge(new HalfEdge(i_PtA)),
+    m_ID(0),
+    m_Conflicts(),
+    m_Epoch(0),
+    m_Children(),
+    m_PtsOnFacet()
+{
+    m_AnEdge->connectTo(i_PtB)->connectTo(i_PtC)->connectTo(m_AnEdge);
+}
+
 void Facet::connectTo(sptr<Facet> i_Facet, sPoint i_Pti_PtA, sPoint i_PtB)
 {
     findHalfEdge(i_Pti_PtA, i_PtB)->twinTo(i_Facet->findHalfEdge(i_Pti_PtA, i_PtB));
@@ -89,6 +106,24 @@ bool Facet::isCoplanarWith(sPoint i_Pt)
     return fabs(dot(m_Normal, *i_Pt) - dot(m_Normal, *(m_AnEdge->m_Origin))) < EPSILON;
 }
 
+void Facet::breakCycles()
+{
+    if (!m_AnEdge) {
+        return;
+    }
+    sptr<HalfEdge> edge(m_AnEdge->m_Next);
+    while (edge && edge != m_AnEdge) {
+        sptr<HalfEdge> next(edge->m_Next);
+        edge->m_Next = edge->m_Prev = edge->m_Twin = NULL;
+        edge->m_Facet = NULL;
+        edge = next;
+    }
+    m_AnEdge->m_Next = m_AnEdge->m_Prev = m_AnEdge->m_Twin = NULL;
+    m_AnEdge->m_Facet = NULL;
+    m_Conflicts.clear();
+    std::vector<uint>().swap(m_PtsOnFacet);
+}
+
 
 /************************************************************************/
 /*                                DCEL                                  */
@@ -96,7 +131,8 @@ bool Facet::isCoplanarWith(sPoint i_Pt)
 
 DCEL3D::DCEL3D(sPoint i_PtA, sPoint i_PtB, sPoint i_PtC, sPoint i_PtD) :
     m_PtInside(new Point((*i_PtA + *i_PtB + *i_PtC + *i_PtD) * 0.25)),
-    m_Facets()
+    m_Facets(),
+    m_InitialFacets()
 {
     // Create first four facets
     sptr<Facet> abc(addFacet(i_PtA, i_PtB, i_PtC));
@@ -118,20 +154,362 @@ DCEL3D::DCEL3D(sPoint i_PtA, sPoint i_PtB, sPoint i_PtC, sPoint i_PtD) :
     abd->connectTo(abc, i_PtA, i_PtB);
     abd->connectTo(bcd, i_PtB, i_PtD);
     abd->connectTo(acd, i_PtA, i_PtD);
+
+    m_InitialFacets = m_Facets;
+}
+
+DCEL3D::DCEL3D(const TriangleMesh& i_Mesh, const std::vector<sPoint>& i_Pts) :
+    m_PtInside(),
+    m_Facets(),
+    m_InitialFacets()
+{
+    // Any average of hull vertices is inside
+    Point inside(0, 0, 0);
+    for (uint vertex : i_Mesh.m_Origins) {
+        inside += Vector(*i_Pts[vertex]);
+    }
+    m_PtInside = sPoint(new Point(inside * (1.0 / i_Mesh.m_Origins.size())));
+
+    // Create facets in the winding of the mesh (a sliver could fail the test
+    // against the inside point) and keep their half-edges in mesh order
+    std::vector<sptr<HalfEdge>> halfEdges;
+    halfEdges.reserve(i_Mesh.m_Origins.size());
+    for (uint halfEdge = 0; halfEdge < i_Mesh.m_Origins.size(); halfEdge += 3) {
+        sptr<Facet> facet(addFacet(sptr<Facet>(new Facet(i_Pts[i_Mesh.m_Origins[halfEdge]], 
+                                                         i_Pts[i_Mesh.m_Origins[halfEdge + 1]], 
+                                                         i_Pts[i_Mesh.m_Origins[halfEdge + 2]]))));
+        halfEdges.push_back(facet->m_AnEdge);
+        halfEdges.push_back(facet->m_AnEdge->m_Next);
+        halfEdges.push_back(facet->m_AnEdge->m_Next->m_Next);
+    }
+
+    // Connect them via twins
+    for (uint halfEdge = 0; halfEdge < i_Mesh.m_Origins.size(); ++halfEdge) {
+        uint twin(i_Mesh.m_Twins[halfEdge]);
+        if (halfEdge < twin) {
+            halfEdges[halfEdge]->twinTo(halfEdges[twin]);
+        }
+    }
+}
+
+// Facets and half-edges reference each other, they would never be freed
+DCEL3D::~DCEL3D()
+{
+    for (const sptr<Facet>& facet : m_Facets) {
+        if (facet) {
+            facet->breakCycles();
+        }
+    }
 }
 
 sptr<Facet> DCEL3D::addFacet(sPoint i_P1, sPoint i_P2, sPoint i_P3)
 {
-    // Create facet
-    sptr<Facet> facet(new Facet(i_P1, i_P2, i_P3, m_PtInside));
+    return addFacet(sptr<Facet>(new Facet(i_P1, i_P2, i_P3, m_PtInside)));
+}
 
+sptr<Facet> DCEL3D::addFacet(sptr<Facet> i_Facet)
+{
     // Add it to the list
-    m_Facets.push_back(facet);
+    i_Facet->m_ID = m_Facets.size();
+    m_Facets.push_back(i_Facet);
 
     // Link edges to facet
-    facet->m_AnEdge->m_Facet = facet;
-    facet->m_AnEdge->m_Next->m_Facet = facet;
-    facet->m_AnEdge->m_Next->m_Next->m_Facet = facet;
+    i_Facet->m_AnEdge->m_Facet = i_Facet;
+    i_Facet->m_AnEdge->m_Next->m_Facet = i_Facet;
+    i_Facet->m_AnEdge->m_Next->m_Next->m_Facet = i_Facet;
+
+    return i_Facet;
+} 
+
+static uint countEdges(const sptr<Facet>& i_Facet)
+{
+    uint nbEdges(0);
+    sptr<HalfEdge> edge(i_Facet->m_AnEdge);
+    do {
+        ++nbEdges;
+        edge = edge->m_Next;
+    } while (edge != i_Facet->m_AnEdge);
+    return nbEdges;
+}
+
+// Distance from i_B to the line (i_A, i_C), signed by the turn i_A, i_B, i_C
+// around i_Normal (unit): negative when i_B makes the polygon concave
+static double turnDistance(const Point& i_A, const Point& i_B, const Point& i_C, const Vector& i_Normal)
+{
+    double length((i_C - i_A).norm());
+    return length > 0 ? dot(cross(i_B - i_A, i_C - i_B), i_Normal) / length : 0;
+}
+
+// Removes the vertex at the end of i_In if it only has two edges, both within
+// i_MaxDistance of a line, and if both its facets keep at least three edges
+static bool removeVertexOfDegree2(const sptr<HalfEdge>& i_In, double i_MaxDistance)
+{
+    sptr<HalfEdge> out(i_In->m_Next);
+    sptr<HalfEdge> twinIn(i_In->m_Twin);
+    sptr<HalfEdge> twinOut(out->m_Twin);
+    if (twinOut->m_Next != twinIn || twinIn->m_Facet == i_In->m_Facet ||
+        countEdges(i_In->m_Facet) <= 3 || countEdges(twinIn->m_Facet) <= 3) {
+        return false;
+    }
+
+    // Only collinear edges: a corner between two facets is still a corner
+    const Point& a(*i_In->m_Origin);
+    const Point& b(*out->m_Origin);
+    const Point& c(*out->m_Next->m_Origin);
+    double length((c - a).norm());
+    if (length == 0 || cross(b - a, c - b).norm() > i_MaxDistance * length) {
+        return false;
+    }
+
+    // Skip the vertex on both sides
+    i_In->m_Next = out->m_Next;
+    out->m_Next->m_Prev = i_In;
+    twinOut->m_Next = twinIn->m_Next;
+    twinIn->m_Next->m_Prev = twinOut;
+    i_In->m_Twin = twinOut;
+    twinOut->m_Twin = i_In;
+
+    if (i_In->m_Facet->m_AnEdge == out) {
+        i_In->m_Facet->m_AnEdge = i_In;
+    }
+    if (twinOut->m_Facet->m_AnEdge == twinIn) {
+        twinOut->m_Facet->m_AnEdge = twinOut;
+    }
+
+    // Break reference cycles
+    out->m_Next = out->m_Prev = out->m_Twin = NULL;
+    twinIn->m_Next = twinIn->m_Prev = twinIn->m_Twin = NULL;
+    return true;
+}
+
+// Removes the dangling edge (an edge followed by its twin, as left by the
+// coplanar case of addNewFace) that starts at the end of i_In, if any
+static bool removeDanglingEdge(const sptr<HalfEdge>& i_In)
+{
+    sptr<HalfEdge> out(i_In->m_Next);
+    sptr<HalfEdge> back(out->m_Twin);
+    if (out->m_Next != back || back->m_Next == i_In) {
+        return false;
+    }
+
+    i_In->m_Next = back->m_Next;
+    back->m_Next->m_Prev = i_In;
+    if (i_In->m_Facet->m_AnEdge == out || i_In->m_Facet->m_AnEdge == back) {
+        i_In->m_Facet->m_AnEdge = i_In;
+    }
+
+    // Break reference cycles
+    out->m_Next = out->m_Prev = out->m_Twin = NULL;
+    back->m_Next = back->m_Prev = back->m_Twin = NULL;
+    return true;
+}
+
+// Whether the vertices of i_Facet are within i_MaxDistance of a plane
+static bool isWithinDistance(const sptr<Facet>& i_Facet, const Vector& i_Normal, double i_Offset, double i_MaxDistance)
+{
+    sptr<HalfEdge> edge(i_Facet->m_AnEdge);
+    do {
+        if (fabs(dot(i_Normal, *edge->m_Origin) - i_Offset) > i_MaxDistance) {
+            return false;
+        }
+        edge = edge->m_Next;
+    } while (edge != i_Facet->m_AnEdge);
+    return true;
+}
+
+uint DCEL3D::mergeCoplanarFacets(double i_MaxAngle, double i_MaxDistance, double i_Flatness, uint& o_NbRemovedVertices)
+{
+    double minCos(cos(i_MaxAngle));
+    uint nbFacets(m_Facets.size());
+    o_NbRemovedVertices = 0;
+
+    // Distance tolerances from the bounding box diagonal of the hull
+    Point minPt(HUGE_VAL, HUGE_VAL, HUGE_VAL);
+    Point maxPt(-HUGE_VAL, -HUGE_VAL, -HUGE_VAL);
+    for (const sptr<Facet>& facet : m_Facets) {
+        if (!facet) {
+            continue;
+        }
+        sptr<HalfEdge> edge(facet->m_AnEdge);
+        do {
+            const Point& pt(*edge->m_Origin);
+            minPt = Point((std::min)(minPt.m_x, pt.m_x), (std::min)(minPt.m_y, pt.m_y), (std::min)(minPt.m_z, pt.m_z));
+            maxPt = Point((std::max)(maxPt.m_x, pt.m_x), (std::max)(maxPt.m_y, pt.m_y), (std::max)(maxPt.m_z, pt.m_z));
+            edge = edge->m_Next;
+        } while (edge != facet->m_AnEdge);
+    }
+    double diagonal(minPt.m_x <= maxPt.m_x ? (maxPt - minPt).norm() : 0);
+    double maxDistance(i_MaxDistance * diagonal);
+    double flatness(i_Flatness * diagonal);
+
+    // Clean up dangling edges first, they are not polygon edges
+    for (const sptr<Facet>& facet : m_Facets) {
+        if (!facet) {
+            continue;
+        }
+
+        // Stop once every edge has been checked since the last removal
+        uint nbEdges(countEdges(facet));
+        uint nbChecked(0);
+        sptr<HalfEdge> edge(facet->m_AnEdge);
+        while (nbChecked < nbEdges) {
+            if (removeDanglingEdge(edge)) {
+                nbEdges -= 2;
+                nbChecked = 0;
+                ++o_NbRemovedVertices;
+            } else {
+                edge = edge->m_Next;
+                ++nbChecked;
+            }
+        }
+    }
+
+    std::vector<Vector> normals(nbFacets);
+    for (const sptr<Facet>& facet : m_Facets) {
+        if (facet) {
+            normals[facet->m_ID] = facet->m_Normal.normalize();
+        }
+    }
+
+    // Region (first facet) of each facet
+    std::vector<uint> regionOf(nbFacets, NO_REGION);
+    std::vector<sptr<Facet>> region;
+    std::vector<sptr<HalfEdge>> boundary;
+    std::vector<sptr<HalfEdge>> interior;
+    uint nbRemovedFacets(0);
+
+    for (uint seed = 0; seed < nbFacets; ++seed) {
+        if (!m_Facets[seed] || regionOf[seed] != NO_REGION) {
+            continue;
+        }
+
+        // Grow the region from the seed. Normals are compared to the seed's,
+        // so the region cannot slowly bend, and every vertex must be within
+        // maxDistance of the seed plane. The seed plane supports the hull, so
+        // the merged facet keeps every point on its inner side.
+        const Vector& seedNormal(normals[seed]);
+        double seedOffset(dot(seedNormal, *m_Facets[seed]->m_AnEdge->m_Origin));
+        region.assign(1, m_Facets[seed]);
+        regionOf[seed] = seed;
+        for (uint i = 0; i < region.size(); ++i) {
+            sptr<HalfEdge> edge(region[i]->m_AnEdge);
+            do {
+                uint neighbor(edge->m_Twin->m_Facet->m_ID);
+                if (regionOf[neighbor] == NO_REGION && dot(normals[neighbor], seedNormal) >= minCos &&
+                    isWithinDistance(m_Facets[neighbor], seedNormal, seedOffset, maxDistance)) {
+                    regionOf[neighbor] = seed;
+                    region.push_back(m_Facets[neighbor]);
+                }
+                edge = edge->m_Next;
+            } while (edge != region[i]->m_AnEdge);
+        }
+        if (region.size() == 1) {
+            continue;
+        }
+
+        // Split half-edges between the boundary and the interior
+        interior.clear();
+        uint nbBoundaryEdges(0);
+        sptr<HalfEdge> start;
+        for (const sptr<Facet>& facet : region) {
+            sptr<HalfEdge> edge(facet->m_AnEdge);
+            do {
+                if (regionOf[edge->m_Twin->m_Facet->m_ID] == seed) {
+                    interior.push_back(edge);
+                } else {
+                    start = edge;
+                    ++nbBoundaryEdges;
+                }
+                edge = edge->m_Next;
+            } while (edge != facet->m_AnEdge);
+        }
+
+        // Walk the boundary. The next boundary edge is found by turning
+        // around the end vertex through facets of the region.
+        boundary.clear();
+        sptr<HalfEdge> edge(start);
+        do {
+            boundary.push_back(edge);
+            edge = edge->m_Next;
+            while (regionOf[edge->m_Twin->m_Facet->m_ID] == seed) {
+                edge = edge->m_Twin->m_Next;
+            }
+        } while (edge != start && boundary.size() <= nbBoundaryEdges);
+
+        // A region with several boundary loops (a hole) is not a polygon, and
+        // a concave one is not a convex polygon. The merged plane passes
+        // through the highest boundary vertex, so a higher interior vertex
+        // would end outside the hull. Keep the facets of such regions apart.
+        bool isConvex(boundary.size() == nbBoundaryEdges);
+        double boundaryHeight(-HUGE_VAL);
+        for (uint i = 0; isConvex && i < boundary.size(); ++i) {
+            const Point& a(*boundary[i]->m_Origin);
+            const Point& b(*boundary[(i + 1) % boundary.size()]->m_Origin);
+            const Point& c(*boundary[(i + 2) % boundary.size()]->m_Origin);
+            isConvex = turnDistance(a, b, c, seedNormal) >= -maxDistance;
+            boundaryHeight = (std::max)(boundaryHeight, dot(seedNormal, a));
+        }
+        for (uint i = 0; isConvex && i < interior.size(); ++i) {
+            isConvex = dot(seedNormal, *interior[i]->m_Origin) <= boundaryHeight;
+        }
+        if (!isConvex) {
+            for (const sptr<Facet>& facet : region) {
+                regionOf[facet->m_ID] = facet->m_ID;
+            }
+            continue;
+        }
+
+        // Link the boundary into the seed facet, which keeps its normal. Its
+        // plane passes through m_AnEdge, the boundary vertex farthest along
+        // the normal (a vertex of the seed when there is one on the boundary).
+        sptr<Facet> merged(m_Facets[seed]);
+        uint highest(0);
+        for (uint i = 0; i < boundary.size(); ++i) {
+            const sptr<HalfEdge>& next(boundary[(i + 1) % boundary.size()]);
+            boundary[i]->m_Next = next;
+            next->m_Prev = boundary[i];
+            boundary[i]->m_Facet = merged;
+            if (dot(seedNormal, *boundary[i]->m_Origin) > dot(seedNormal, *boundary[highest]->m_Origin)) {
+                highest = i;
+            }
+        }
+        merged->m_AnEdge = boundary[highest];
+
+        // Remove the other facets and break reference cycles
+        for (const sptr<HalfEdge>& interiorEdge : interior) {
+            interiorEdge->m_Next = interiorEdge->m_Prev = interiorEdge->m_Twin = NULL;
+            interiorEdge->m_Facet = NULL;
+        }
+        for (const sptr<Facet>& facet : region) {
+            if (facet != merged) {
+                facet->m_AnEdge = NULL;
+                m_Facets[facet->m_ID] = NULL;
+                ++nbRemovedFacets;
+            }
+        }
+    }
+
+    // Remove vertices between two facets
+    for (const sptr<Facet>& facet : m_Facets) {
+        if (!facet) {
+            continue;
+        }
+
+        // Stop once every edge has been checked since the last removal
+        uint nbEdges(countEdges(facet));
+        uint nbChecked(0);
+        sptr<HalfEdge> edge(facet->m_AnEdge);
+        while (nbChecked < nbEdges && nbEdges > 3) {
+            if (removeVertexOfDegree2(edge, flatness)) {
+                --nbEdges;
+                nbChecked = 0;
+                ++o_NbRemovedVertices;
+            } else {
+                edge = edge->m_Next;
+                ++nbChecked;
+            }
+        }
+    }
 
-    return facet;
-} 
\ No newline at end of file
+    return nbRemovedFacets;
+}
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "Point.h"
+#include "TriangleMesh.h"
 
 #define EPSILON 1e-8
 #define sptr std::shared_ptr
@@ -38,13 +39,22 @@ struct Facet : std::enable_shared_from_this<Facet>
 {
     sptr<HalfEdge> m_AnEdge;
     Vector         m_Normal;
-    uint           m_ID;
+    uint           m_ID;       // Index in DCEL3D::m_Facets
     std::set<uint> m_Conflicts;
+    uint           m_Epoch;
 
-    static uint    s_LastID;
+    // Facets created next to this one (history DAG)
+    std::vector<sptr<Facet>> m_Children;
+
+    // Points found inside the hull that lie on the plane of this facet
+    // (membership tracking)
+    std::vector<uint> m_PtsOnFacet;
 
     Facet(sPoint i_PtA, sPoint i_PtB, sPoint i_PtC, sPoint i_InsideDCEL3D);
 
+    // Counterclockwise seen from outside, as given
+    Facet(sPoint i_PtA, sPoint i_PtB, sPoint i_PtC);
+
     void connectTo(sptr<Facet> i_Facet, sPoint i_PtA, sPoint i_PtB);
 
     sptr<HalfEdge> findHalfEdge(sPoint i_PtA, sPoint i_PtB);
@@ -52,6 +62,11 @@ struct Facet : std::enable_shared_from_this<Facet>
     bool isVisibleBy(sPoint i_Pt);
 
     bool isCoplanarWith(sPoint i_Pt);
+
+    // Unlinks the half-edges of the facet (and itself) so that they are
+    // freed once the facet is no longer used, and drops its points. Only
+    // the plane is left (m_AnEdge keeps its origin), as the history DAG needs.
+    void breakCycles();
 };
 
 struct DCEL3D
@@ -59,9 +74,26 @@ struct DCEL3D
     sPoint        m_PtInside;
     std::vector<sptr<Facet>> m_Facets;
 
+    // Facets of the initial tetrahedron (roots of the history DAG)
+    std::vector<sptr<Facet>> m_InitialFacets;
+
     DCEL3D(sPoint i_PtA, sPoint i_PtB, sPoint i_PtC, sPoint i_PtD);
+    DCEL3D(const TriangleMesh& i_Mesh, const std::vector<sPoint>& i_Pts);
+    ~DCEL3D();
 
     sptr<Facet> addFacet(sPoint i_P1, sPoint i_P2, sPoint i_P3);
+    sptr<Facet> addFacet(sptr<Facet> i_Facet);
+
+    // Merges adjacent facets whose normals are within i_MaxAngle (radians) of
+    // the normal of the first facet of their region, and whose vertices are
+    // within i_MaxDistance times the bounding box diagonal of its plane, into
+    // single convex polygons (regions that are not convex within the same
+    // distance, or whose highest vertex is not on their boundary, are left
+    // apart). Then removes dangling edges and vertices left between only two
+    // facets when their edges are collinear within i_Flatness times the
+    // diagonal. Returns the number of facets removed. Invalidates the history
+    // DAG.
+    uint mergeCoplanarFacets(double i_MaxAngle, double i_MaxDistance, double i_Flatness, uint& o_NbRemovedVertices);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+#include "Deduplication.h"
+#include "Parallel.h"
+
+/************************************************************************/
+/*                              CellKey                                 */
+/************************************************************************/
+
+struct CellKey
+{
+    unsigned long long m_Coords[3];
+
+    bool operator==(const CellKey& i_Other) const
+    {
+        return m_Coords[0] == i_Other.m_Coords[0] &&
+               m_Coords[1] == i_Other.m_Coords[1] &&
+               m_Coords[2] == i_Other.m_Coords[2];
+    }
+};
+
+struct CellKeyHash
+{
+    size_t operator()(const CellKey& i_Key) const
+    {
+        // Mix the three coordinates (64-bit variant of boost::hash_combine)
+        unsigned long long hash(0);
+        for (unsigned long long coord : i_Key.m_Coords) {
+            hash ^= coord + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        }
+        return size_t(hash ^ (hash >> 32));
+    }
+};
+
+// Partition of a cell. The partition maps key their cells with the same
+// hash, so partitioning on its low bits (hash % nbPartitions) would leave each
+// map using 1 / nbPartitions of its buckets when they are a power of two (as
+// with MSVC). Remix the hash and keep the high bits instead (multiply-shift).
+static uint partitionOf(size_t i_Hash, uint i_NbPartitions)
+{
+    unsigned long long mixed(((unsigned long long)i_Hash * 0x9e3779b97f4a7c15ULL) >> 32);
+    return uint((mixed * i_NbPartitions) >> 32);
+}
+
+static unsigned long long coordToKey(double i_Coord, double i_Tolerance)
+{
+    // Snap to the grid
+    if (i_Tolerance > 0) {
+        return (unsigned long long)(long long)floor(i_Coord / i_Tolerance);
+    }
+
+    // Use bit pattern, but make sure -0.0 and 0.0 are the same
+    if (i_Coord == 0) {
+        i_Coord = 0;
+    }
+    unsigned long long bits;
+    memcpy(&bits, &i_Coord, sizeof(bits));
+    return bits;
+}
+
+
+static CellKey keyOf(const Point& i_Pt, double i_Tolerance)
+{
+    CellKey key;
+    key.m_Coords[0] = coordToKey(i_Pt.m_x, i_Tolerance);
+    key.m_Coords[1] = coordToKey(i_Pt.m_y, i_Tolerance);
+    key.m_Coords[2] = coordToKey(i_Pt.m_z, i_Tolerance);
+    return key;
+}
+
+
+/************************************************************************/
+/*                        findRepresentatives                           */
+/************************************************************************/
+
+std::vector<uint> findRepresentatives(const std::vector<sPoint>& i_Pts, double i_Tolerance)
+{
+    uint nbPts(i_Pts.size());
+    uint nbPartitions(nbThreads());
+    std::vector<CellKey> keys(nbPts);
+    std::vector<uint>    partitions(nbPts);
+    std::vector<uint>    representatives(nbPts);
+
+    // Compute cell keys, and count the points of each partition per chunk
+    std::vector<std::vector<uint>> offsets(nbThreads(), std::vector<uint>(nbPartitions, 0));
+    parallelFor(0, nbPts, [&](uint i_ThreadID, uint i_Begin, uint i_End) {
+        CellKeyHash hasher;
+        std::vector<uint>& counts(offsets[i_ThreadID]);
+        for (uint i = i_Begin; i < i_End; ++i) {
+            keys[i] = keyOf(*i_Pts[i], i_Tolerance);
+            partitions[i] = partitionOf(hasher(keys[i]), nbPartitions);
+            ++counts[partitions[i]];
+        }
+    });
+
+    // Bucket points by partition (counting sort). Chunks are scattered in
+    // order, so each partition lists its points in increasing order.
+    std::vector<uint> partitionStarts(nbPartitions + 1);
+    uint offset(0);
+    for (uint partition = 0; partition < nbPartitions; ++partition) {
+        partitionStarts[partition] = offset;
+        for (std::vector<uint>& counts : offsets) {
+            uint count(counts[partition]);
+            counts[partition] = offset;
+            offset += count;
+        }
+    }
+    partitionStarts[nbPartitions] = offset;
+
+    std::vector<uint> ptsByPartition(nbPts);
+    parallelFor(0, nbPts, [&](uint i_ThreadID, uint i_Begin, uint i_End) {
+        std::vector<uint>& next(offsets[i_ThreadID]);
+        for (uint i = i_Begin; i < i_End; ++i) {
+            ptsByPartition[next[partitions[i]]++] = i;
+        }
+    });
+
+    // Each thread owns the cells whose hash falls in its partition, so no
+    // synchronization is needed. Points are visited in increasing order so
+    // the representative of a cell is always its first point.
+    parallelFor(0, nbPartitions, [&](uint, uint i_Begin, uint i_End) {
+        for (uint partition = i_Begin; partition < i_End; ++partition) {
+            std::unordered_map<CellKey, uint, CellKeyHash> firstPtOfCell;
+            firstPtOfCell.reserve(partitionStarts[partition + 1] - partitionStarts[partition]);
+            for (uint j = partitionStarts[partition]; j < partitionStarts[partition + 1]; ++j) {
+                uint i(ptsByPartition[j]);
+                representatives[i] = firstPtOfCell.emplace(keys[i], i).first->second;
+            }
+        }
+    });
+
+    return representatives;
+}
+
+
+/************************************************************************/
+/*                       estimateDuplicateRate                          */
+/************************************************************************/
+
+double estimateDuplicateRate(const std::vector<sPoint>& i_Pts, const std::vector<uint>& i_Sample,
+                             double i_Tolerance)
+{
+    if (i_Sample.empty()) {
+        return 0;
+    }
+
+    // Distinct cells of the sampled points
+    std::unordered_map<CellKey, uint, CellKeyHash> cellOfKey;
+    cellOfKey.reserve(i_Sample.size());
+    std::vector<uint> cellOfSample(i_Sample.size());
+    for (uint i = 0; i < i_Sample.size(); ++i) {
+        uint nbCells(cellOfKey.size());
+        cellOfSample[i] = cellOfKey.emplace(keyOf(*i_Pts[i_Sample[i]], i_Tolerance), nbCells).first->second;
+    }
+
+    // Count the input points in these cells, in one pass over the input
+    std::vector<std::vector<uint>> counts(nbThreads(), std::vector<uint>(cellOfKey.size(), 0));
+    parallelFor(0, i_Pts.size(), [&](uint i_ThreadID, uint i_Begin, uint i_End) {
+        std::vector<uint>& threadCounts(counts[i_ThreadID]);
+        for (uint i = i_Begin; i < i_End; ++i) {
+            std::unordered_map<CellKey, uint, CellKeyHash>::const_iterator cell(
+                cellOfKey.find(keyOf(*i_Pts[i], i_Tolerance)));
+            if (cell != cellOfKey.end()) {
+                ++threadCounts[cell->second];
+            }
+        }
+    });
+    std::vector<uint> nbPtsInCell(cellOfKey.size(), 0);
+    for (const std::vector<uint>& threadCounts : counts) {
+        for (uint cell = 0; cell < nbPtsInCell.size(); ++cell) {
+            nbPtsInCell[cell] += threadCounts[cell];
+        }
+    }
+
+    // A sampled point is merged with another point when its cell holds more
+    // than one input point
+    uint nbMerged(0);
+    for (uint cell : cellOfSample) {
+        nbMerged += nbPtsInCell[cell] > 1 ? 1 : 0;
+    }
+    return double(nbMerged) / i_Sample.size();
+}
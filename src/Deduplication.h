@@ -0,0 +1,20 @@
+#ifndef __Deduplication__
+#define __Deduplication__
+
+#include <vector>
+
+#include "DCEL3D.h"
+
+// For each point, finds the index of the first point that falls in the same
+// cell of a grid of size i_Tolerance. With a null tolerance, only exact
+// duplicates are merged. Runs in parallel.
+std::vector<uint> findRepresentatives(const std::vector<sPoint>& i_Pts, double i_Tolerance);
+
+// Estimated fraction of the points of i_Pts that findRepresentatives would
+// merge with another point: the fraction of sampled points (indices in i_Pts)
+// whose cell holds other input points. The input is read once in parallel,
+// looking up each point in the cells of the sample (O(s) memory).
+double estimateDuplicateRate(const std::vector<sPoint>& i_Pts, const std::vector<uint>& i_Sample,
+                             double i_Tolerance);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Degeneracy.h"
+#include "Parallel.h"
+
+// Eigen decomposition of a symmetric 3x3 matrix (cyclic Jacobi). Columns of
+// o_Vectors are the eigenvectors.
+static void jacobiEigen(double io_A[3][3], double o_Values[3], double o_Vectors[3][3])
+{
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            o_Vectors[i][j] = i == j ? 1 : 0;
+        }
+    }
+
+    for (int sweep = 0; sweep < 50; ++sweep) {
+        double offDiagonal(fabs(io_A[0][1]) + fabs(io_A[0][2]) + fabs(io_A[1][2]));
+        if (offDiagonal == 0) {
+            break;
+        }
+        for (int p = 0; p < 2; ++p) {
+            for (int q = p + 1; q < 3; ++q) {
+                if (io_A[p][q] == 0) {
+                    continue;
+                }
+                // Rotation that zeroes A[p][q]
+                double theta((io_A[q][q] - io_A[p][p]) / (2 * io_A[p][q]));
+                double t((theta >= 0 ? 1 : -1) / (fabs(theta) + sqrt(theta * theta + 1)));
+                double c(1 / sqrt(t * t + 1));
+                double s(t * c);
+
+                for (int k = 0; k < 3; ++k) {
+                    double akp(io_A[k][p]), akq(io_A[k][q]);
+                    io_A[k][p] = c * akp - s * akq;
+                    io_A[k][q] = s * akp + c * akq;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    double apk(io_A[p][k]), aqk(io_A[q][k]);
+                    io_A[p][k] = c * apk - s * aqk;
+                    io_A[q][k] = s * apk + c * aqk;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    double vkp(o_Vectors[k][p]), vkq(o_Vectors[k][q]);
+                    o_Vectors[k][p] = c * vkp - s * vkq;
+                    o_Vectors[k][q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        o_Values[i] = io_A[i][i];
+    }
+}
+
+FlatnessInfo analyzeFlatness(const std::vector<sPoint>& i_Pts, double i_Tolerance)
+{
+    FlatnessInfo info;
+    uint nbPts(i_Pts.size());
+    if (nbPts == 0) {
+        info.m_Dimension = 0;
+        info.m_MaxLineDist = info.m_MaxPlaneDist = 0;
+        return info;
+    }
+
+    // Accumulate moments relative to the first point (limits cancellation)
+    struct Moments
+    {
+        double m_Sum[3];
+        double m_Products[3][3];
+        Point  m_Min;
+        Point  m_Max;
+    };
+    const Point& origin(*i_Pts[0]);
+    std::vector<Moments> moments(nbThreads());
+    parallelFor(0, nbPts, [&](uint i_Thread, uint i_Begin, uint i_End) {
+        Moments m = { { 0, 0, 0 }, { { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 } }, origin, origin };
+        for (uint i = i_Begin; i < i_End; ++i) {
+            Vector d(*i_Pts[i] - origin);
+            for (int a = 0; a < 3; ++a) {
+                m.m_Sum[a] += d[a];
+                for (int b = a; b < 3; ++b) {
+                    m.m_Products[a][b] += d[a] * d[b];
+                }
+                m.m_Min[a] = (std::min)(m.m_Min[a], (*i_Pts[i])[a]);
+                m.m_Max[a] = (std::max)(m.m_Max[a], (*i_Pts[i])[a]);
+            }
+        }
+        moments[i_Thread] = m;
+    });
+    for (uint t = 1; t < moments.size(); ++t) {
+        for (int a = 0; a < 3; ++a) {
+            moments[0].m_Sum[a] += moments[t].m_Sum[a];
+            for (int b = a; b < 3; ++b) {
+                moments[0].m_Products[a][b] += moments[t].m_Products[a][b];
+            }
+            moments[0].m_Min[a] = (std::min)(moments[0].m_Min[a], moments[t].m_Min[a]);
+            moments[0].m_Max[a] = (std::max)(moments[0].m_Max[a], moments[t].m_Max[a]);
+        }
+    }
+
+    // Covariance matrix and its principal axes
+    double mean[3], covariance[3][3];
+    for (int a = 0; a < 3; ++a) {
+        mean[a] = moments[0].m_Sum[a] / nbPts;
+    }
+    for (int a = 0; a < 3; ++a) {
+        for (int b = a; b < 3; ++b) {
+            covariance[a][b] = covariance[b][a] = moments[0].m_Products[a][b] / nbPts - mean[a] * mean[b];
+        }
+    }
+    double values[3], vectors[3][3];
+    jacobiEigen(covariance, values, vectors);
+
+    int order[3] = { 0, 1, 2 };
+    std::sort(order, order + 3, [&values](int i_A, int i_B) { return values[i_A] > values[i_B]; });
+    for (int i = 0; i < 2; ++i) {
+        info.m_Axes[i] = Vector(vectors[0][order[i]], vectors[1][order[i]], vectors[2][order[i]]);
+    }
+    info.m_Axes[2] = cross(info.m_Axes[0], info.m_Axes[1]);
+    info.m_Centroid = origin + Vector(mean[0], mean[1], mean[2]);
+
+    // Largest distances from the fitted line and plane
+    std::vector<double> lineDists(nbThreads(), 0), planeDists(nbThreads(), 0);
+    parallelFor(0, nbPts, [&](uint i_Thread, uint i_Begin, uint i_End) {
+        for (uint i = i_Begin; i < i_End; ++i) {
+            Vector d(*i_Pts[i] - info.m_Centroid);
+            lineDists[i_Thread] = (std::max)(lineDists[i_Thread], cross(info.m_Axes[0], d).squareNorm());
+            planeDists[i_Thread] = (std::max)(planeDists[i_Thread], fabs(dot(info.m_Axes[2], d)));
+        }
+    });
+    info.m_MaxLineDist = sqrt(*std::max_element(lineDists.begin(), lineDists.end()));
+    info.m_MaxPlaneDist = *std::max_element(planeDists.begin(), planeDists.end());
+
+    // Classify
+    double tolerance(i_Tolerance * (moments[0].m_Max - moments[0].m_Min).norm());
+    if ((moments[0].m_Max - moments[0].m_Min).norm() <= tolerance || nbPts == 1) {
+        info.m_Dimension = 0;
+    } else if (info.m_MaxLineDist <= tolerance || nbPts == 2) {
+        info.m_Dimension = 1;
+    } else if (info.m_MaxPlaneDist <= tolerance || nbPts == 3) {
+        info.m_Dimension = 2;
+    } else {
+        info.m_Dimension = 3;
+    }
+    return info;
+}
+
+DegenerateHull computeDegenerateHull(const std::vector<sPoint>& i_Pts, const FlatnessInfo& i_Info)
+{
+    DegenerateHull hull;
+    hull.m_Dimension = i_Info.m_Dimension;
+    hull.m_Normal = i_Info.m_Axes[2];
+
+    if (i_Pts.empty()) {
+        return hull;
+    }
+    if (i_Info.m_Dimension == 0) {
+        hull.m_Vertices.push_back(0);
+        return hull;
+    }
+
+    // Project points in the fitted line or plane
+    uint nbPts(i_Pts.size());
+    std::vector<double> u(nbPts), v(nbPts);
+    parallelFor(0, nbPts, [&](uint, uint i_Begin, uint i_End) {
+        for (uint i = i_Begin; i < i_End; ++i) {
+            Vector d(*i_Pts[i] - i_Info.m_Centroid);
+            u[i] = dot(i_Info.m_Axes[0], d);
+            v[i] = dot(i_Info.m_Axes[1], d);
+        }
+    });
+
+    // Collinear: both ends of the segment
+    if (i_Info.m_Dimension == 1) {
+        hull.m_Vertices.push_back(std::min_element(u.begin(), u.end()) - u.begin());
+        hull.m_Vertices.push_back(std::max_element(u.begin(), u.end()) - u.begin());
+        return hull;
+    }
+
+    // Planar: Andrew's monotone chain
+    std::vector<uint> sorted(nbPts);
+    for (uint i = 0; i < nbPts; ++i) {
+        sorted[i] = i;
+    }
+    std::sort(sorted.begin(), sorted.end(), [&u, &v](uint i_A, uint i_B) {
+        return u[i_A] < u[i_B] || (u[i_A] == u[i_B] && v[i_A] < v[i_B]);
+    });
+
+    // Turn of a -> b -> c (positive when counter-clockwise)
+    auto turn = [&u, &v](uint i_A, uint i_B, uint i_C) {
+        return (u[i_B] - u[i_A]) * (v[i_C] - v[i_A]) - (v[i_B] - v[i_A]) * (u[i_C] - u[i_A]);
+    };
+
+    std::vector<uint>& chain(hull.m_Vertices);
+    chain.resize(2 * nbPts);
+    uint k(0);
+    // Lower hull
+    for (uint i = 0; i < nbPts; ++i) {
+        while (k >= 2 && turn(chain[k - 2], chain[k - 1], sorted[i]) <= 0) {
+            --k;
+        }
+        chain[k++] = sorted[i];
+    }
+    // Upper hull
+    for (uint i = nbPts - 1, lowerSize = k + 1; i > 0; --i) {
+        while (k >= lowerSize && turn(chain[k - 2], chain[k - 1], sorted[i - 1]) <= 0) {
+            --k;
+        }
+        chain[k++] = sorted[i - 1];
+    }
+    // Last point is the first one
+    chain.resize(k - 1);
+    return hull;
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#ifndef __Degeneracy__
+#define __Degeneracy__
+
+#include <vector>
+
+#include "DCEL3D.h"
+
+// Principal axes of a point set and how far points are from the fitted line
+// and plane
+struct FlatnessInfo
+{
+    uint   m_Dimension;     // 0 (single point), 1 (collinear), 2 (planar) or 3
+    Point  m_Centroid;
+    Vector m_Axes[3];       // Unit axes, by decreasing spread (right-handed)
+    double m_MaxLineDist;   // Max distance from the line (centroid, axis 0)
+    double m_MaxPlaneDist;  // Max distance from the plane (centroid, axis 2)
+};
+
+// Hull of input that is not full-dimensional: a point, a segment or a convex
+// polygon (counter-clockwise around m_Normal), as indices in the input
+struct DegenerateHull
+{
+    uint              m_Dimension;
+    std::vector<uint> m_Vertices;
+    Vector            m_Normal;
+};
+
+// Fits a line and a plane to the points (one parallel pass for the covariance,
+// one for the distances). Points within i_Tolerance times the bounding box
+// diagonal of the line (plane) are considered on it.
+FlatnessInfo analyzeFlatness(const std::vector<sPoint>& i_Pts, double i_Tolerance);
+
+// Hull of points that are not full-dimensional, computed in the fitted line or
+// plane (monotone chain for planar input)
+DegenerateHull computeDegenerateHull(const std::vector<sPoint>& i_Pts, const FlatnessInfo& i_Info);
+
+#endif
\ No newline at end of file
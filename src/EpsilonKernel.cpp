@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "EpsilonKernel.h"
+#include "Parallel.h"
+
+#define NO_POINT uint(-1)
+
+/************************************************************************/
+/*                              Columns                                 */
+/************************************************************************/
+
+// Lowest and highest point of each column
+struct ColumnExtremes
+{
+    std::vector<uint> m_Low;
+    std::vector<uint> m_High;
+
+    // Ties go to the lowest index, so the result does not depend on the
+    // number of threads
+    void add(uint i_Column, uint i_Pt, const std::vector<sPoint>& i_Pts, int i_Axis)
+    {
+        double height((*i_Pts[i_Pt])[i_Axis]);
+        uint& low(m_Low[i_Column]);
+        uint& high(m_High[i_Column]);
+        if (low == NO_POINT) {
+            low = high = i_Pt;
+            return;
+        }
+        double lowHeight((*i_Pts[low])[i_Axis]);
+        if (height < lowHeight || (height == lowHeight && i_Pt < low)) {
+            low = i_Pt;
+        }
+        double highHeight((*i_Pts[high])[i_Axis]);
+        if (height > highHeight || (height == highHeight && i_Pt < high)) {
+            high = i_Pt;
+        }
+    }
+};
+
+/************************************************************************/
+/*                        computeEpsilonKernel                          */
+/************************************************************************/
+
+std::vector<uint> computeEpsilonKernel(const std::vector<sPoint>& i_Pts, double i_Epsilon, double& o_Bound)
+{
+    uint nbPts(i_Pts.size());
+    o_Bound = 0;
+
+    // Bounding box
+    std::vector<Point> mins(nbThreads()), maxs(nbThreads());
+    parallelFor(0, nbPts, [&](uint i_ThreadID, uint i_Begin, uint i_End) {
+        double inf(std::numeric_limits<double>::infinity());
+        Point min(inf, inf, inf), max(-inf, -inf, -inf);
+        for (uint i = i_Begin; i < i_End; ++i) {
+            const Point& pt(*i_Pts[i]);
+            for (int axis = 0; axis < 3; ++axis) {
+                min[axis] = (std::min)(min[axis], pt[axis]);
+                max[axis] = (std::max)(max[axis], pt[axis]);
+            }
+        }
+        mins[i_ThreadID] = min;
+        maxs[i_ThreadID] = max;
+    });
+    Point min(mins[0]), max(maxs[0]);
+    for (uint i = 1; i < mins.size(); ++i) {
+        for (int axis = 0; axis < 3; ++axis) {
+            min[axis] = (std::min)(min[axis], mins[i][axis]);
+            max[axis] = (std::max)(max[axis], maxs[i][axis]);
+        }
+    }
+
+    std::vector<uint> kernel;
+    Vector extent(max - min);
+    double diagonal(extent.norm());
+    if (nbPts == 0 || !(diagonal > 0)) {
+        for (uint i = 0; i < nbPts; ++i) {
+            kernel.push_back(i);
+        }
+        return kernel;
+    }
+
+    // Columns go along the longest axis. The diameter is at least diag/sqrt(3)
+    // and the error at most the column diagonal, sqrt(2) times its side.
+    int axis(0);
+    for (int i = 1; i < 3; ++i) {
+        axis = extent[i] > extent[axis] ? i : axis;
+    }
+    int axisU((axis + 1) % 3), axisV((axis + 2) % 3);
+
+    double side(i_Epsilon * diagonal / sqrt(6.0));
+    auto nbColumnsAlong = [&](int i_Axis) {
+        return (std::max)(1.0, ceil(extent[i_Axis] / side));
+    };
+    if (!(side > 0) || nbColumnsAlong(axisU) * nbColumnsAlong(axisV) > MAX_KERNEL_COLUMNS) {
+        // Smallest side that fits, slightly enlarged against rounding
+        side = sqrt(extent[axisU] * extent[axisV] / MAX_KERNEL_COLUMNS);
+        side = (std::max)(side, (std::max)(extent[axisU], extent[axisV]) / MAX_KERNEL_COLUMNS);
+        while (nbColumnsAlong(axisU) * nbColumnsAlong(axisV) > MAX_KERNEL_COLUMNS) {
+            side *= 1.01;
+        }
+    }
+    uint nbU(nbColumnsAlong(axisU)), nbV(nbColumnsAlong(axisV));
+    uint nbColumns(nbU * nbV);
+    o_Bound = side * sqrt(6.0) / diagonal;
+
+    auto columnOf = [&](const Point& i_Pt) {
+        uint u((std::min)(uint((i_Pt[axisU] - min[axisU]) / side), nbU - 1));
+        uint v((std::min)(uint((i_Pt[axisV] - min[axisV]) / side), nbV - 1));
+        return v * nbU + u;
+    };
+
+    // Extremes per thread, over consecutive points
+    std::vector<ColumnExtremes> extremes(nbThreads());
+    parallelFor(0, nbPts, [&](uint i_ThreadID, uint i_Begin, uint i_End) {
+        ColumnExtremes& threadExtremes(extremes[i_ThreadID]);
+        threadExtremes.m_Low.assign(nbColumns, NO_POINT);
+        threadExtremes.m_High.assign(nbColumns, NO_POINT);
+        for (uint i = i_Begin; i < i_End; ++i) {
+            threadExtremes.add(columnOf(*i_Pts[i]), i, i_Pts, axis);
+        }
+    });
+
+    // Merged into the first thread's arrays, in parallel over columns
+    ColumnExtremes& merged(extremes[0]);
+    parallelFor(0, nbColumns, [&](uint, uint i_Begin, uint i_End) {
+        for (uint i = 1; i < extremes.size(); ++i) {
+            if (extremes[i].m_Low.empty()) {
+                continue;
+            }
+            for (uint column = i_Begin; column < i_End; ++column) {
+                if (extremes[i].m_Low[column] != NO_POINT) {
+                    merged.add(column, extremes[i].m_Low[column], i_Pts, axis);
+                    merged.add(column, extremes[i].m_High[column], i_Pts, axis);
+                }
+            }
+        }
+    });
+
+    for (uint column = 0; column < nbColumns; ++column) {
+        if (merged.m_Low[column] != NO_POINT) {
+            kernel.push_back(merged.m_Low[column]);
+            kernel.push_back(merged.m_High[column]);
+        }
+    }
+    std::sort(kernel.begin(), kernel.end());
+    kernel.erase(std::unique(kernel.begin(), kernel.end()), kernel.end());
+    return kernel;
+}
\ No newline at end of file
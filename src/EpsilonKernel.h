@@ -0,0 +1,21 @@
+#ifndef __EpsilonKernel__
+#define __EpsilonKernel__
+
+#include <vector>
+
+#include "DCEL3D.h"
+
+// Columns of the grid are capped to this many, which bounds memory (8 bytes
+// per column and per thread) but also how small the error can get
+#define MAX_KERNEL_COLUMNS (1u << 20)
+
+// Indices (increasing) of a subset of the points whose hull is within
+// i_Epsilon times the diameter of the points from every point. The bounding
+// box is cut in square columns along its longest axis and only the lowest
+// and highest point of each column are kept: any other point of the column
+// is then within a column diagonal of their segment. o_Bound receives the
+// guaranteed error as a fraction of the diameter, larger than asked when the
+// number of columns was capped. Runs in parallel, in linear time.
+std::vector<uint> computeEpsilonKernel(const std::vector<sPoint>& i_Pts, double i_Epsilon, double& o_Bound);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include <cmath>
+
+#include "ExactPredicates.h"
+
+// Largest expansion built by computeExactOrientation: 3 products of 16 by 2
+// components, each giving 64
+#define MAX_COMPONENTS 192
+
+// Sum of non-overlapping doubles in increasing magnitude, without zeros. Its
+// sign is the sign of its last component.
+struct Expansion
+{
+    double m_Components[MAX_COMPONENTS];
+    int    m_Size;
+};
+
+// i_A + i_B == o_Sum + o_Error exactly
+static void twoSum(double i_A, double i_B, double& o_Sum, double& o_Error)
+{
+    o_Sum = i_A + i_B;
+    double bVirtual(o_Sum - i_A);
+    double aVirtual(o_Sum - bVirtual);
+    o_Error = (i_A - aVirtual) + (i_B - bVirtual);
+}
+
+// Same when |i_A| >= |i_B|
+static void fastTwoSum(double i_A, double i_B, double& o_Sum, double& o_Error)
+{
+    o_Sum = i_A + i_B;
+    o_Error = i_B - (o_Sum - i_A);
+}
+
+// i_A * i_B == o_Product + o_Error exactly
+static void twoProduct(double i_A, double i_B, double& o_Product, double& o_Error)
+{
+    o_Product = i_A * i_B;
+    o_Error = std::fma(i_A, i_B, -o_Product);
+}
+
+static void removeZeros(Expansion& io_E)
+{
+    int size(0);
+    for (int i = 0; i < io_E.m_Size; ++i) {
+        if (io_E.m_Components[i] != 0) {
+            io_E.m_Components[size++] = io_E.m_Components[i];
+        }
+    }
+    io_E.m_Size = size;
+}
+
+// i_A - i_B as an expansion of at most two components
+static void difference(double i_A, double i_B, Expansion& o_E)
+{
+    twoSum(i_A, -i_B, o_E.m_Components[1], o_E.m_Components[0]);
+    o_E.m_Size = 2;
+    removeZeros(o_E);
+}
+
+// o_H = i_E + i_F (EXPANSION-SUM: each component of i_F is added to the
+// components of the sum that are not smaller than it)
+static void add(const Expansion& i_E, const Expansion& i_F, Expansion& o_H)
+{
+    o_H = i_E;
+    for (int i = 0; i < i_F.m_Size; ++i) {
+        double q(i_F.m_Components[i]);
+        for (int j = i; j < i + i_E.m_Size; ++j) {
+            twoSum(q, o_H.m_Components[j], q, o_H.m_Components[j]);
+        }
+        o_H.m_Components[i + i_E.m_Size] = q;
+    }
+    o_H.m_Size = i_E.m_Size + i_F.m_Size;
+    removeZeros(o_H);
+}
+
+static void negate(Expansion& io_E)
+{
+    for (int i = 0; i < io_E.m_Size; ++i) {
+        io_E.m_Components[i] = -io_E.m_Components[i];
+    }
+}
+
+// o_H = i_E * i_B (SCALE-EXPANSION)
+static void scale(const Expansion& i_E, double i_B, Expansion& o_H)
+{
+    o_H.m_Size = 0;
+    if (i_E.m_Size == 0 || i_B == 0) {
+        return;
+    }
+    double q;
+    twoProduct(i_E.m_Components[0], i_B, q, o_H.m_Components[0]);
+    for (int i = 1; i < i_E.m_Size; ++i) {
+        double product, error, sum;
+        twoProduct(i_E.m_Components[i], i_B, product, error);
+        twoSum(q, error, sum, o_H.m_Components[2 * i - 1]);
+        fastTwoSum(product, sum, q, o_H.m_Components[2 * i]);
+    }
+    o_H.m_Components[2 * i_E.m_Size - 1] = q;
+    o_H.m_Size = 2 * i_E.m_Size;
+    removeZeros(o_H);
+}
+
+// o_H = i_E * i_F
+static void multiply(const Expansion& i_E, const Expansion& i_F, Expansion& o_H)
+{
+    Expansion term, sum;
+    o_H.m_Size = 0;
+    for (int i = 0; i < i_F.m_Size; ++i) {
+        scale(i_E, i_F.m_Components[i], term);
+        add(o_H, term, sum);
+        o_H = sum;
+    }
+}
+
+static int sign(const Expansion& i_E)
+{
+    if (i_E.m_Size == 0) {
+        return 0;
+    }
+    return i_E.m_Components[i_E.m_Size - 1] > 0 ? 1 : -1;
+}
+
+int computeExactOrientation(const Point& i_A, const Point& i_B, const Point& i_C, const Point& i_D)
+{
+    // Edge vectors, exactly
+    Expansion u[3], v[3], w[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        difference(i_B[axis], i_A[axis], u[axis]);
+        difference(i_C[axis], i_A[axis], v[axis]);
+        difference(i_D[axis], i_A[axis], w[axis]);
+    }
+
+    // Sum of normal component times w over the three axes
+    Expansion determinant, product, term, normal, sum;
+    determinant.m_Size = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        int next((axis + 1) % 3), last((axis + 2) % 3);
+        multiply(u[next], v[last], product);
+        multiply(u[last], v[next], term);
+        negate(term);
+        add(product, term, normal);
+        multiply(normal, w[axis], term);
+        add(determinant, term, sum);
+        determinant = sum;
+    }
+    return sign(determinant);
+}
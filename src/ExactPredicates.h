@@ -0,0 +1,14 @@
+#ifndef __ExactPredicates__
+#define __ExactPredicates__
+
+#include "Point.h"
+
+// Sign of dot(cross(i_B - i_A, i_C - i_A), i_D - i_A), computed exactly with
+// expansion arithmetic (Shewchuk, "Adaptive Precision Floating-Point
+// Arithmetic and Fast Robust Geometric Predicates"): positive when i_D is
+// above the plane of the triangle, seen counterclockwise. Exact as long as no
+// product overflows or underflows. Much slower than the double expression,
+// so it is only the fallback of filtered predicates.
+int computeExactOrientation(const Point& i_A, const Point& i_B, const Point& i_C, const Point& i_D);
+
+#endif
@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+
+#include "FrozenHull.h"
+
+static size_t alignUp(size_t i_Size)
+{
+    return (i_Size + FrozenHull::ALIGNMENT - 1) / FrozenHull::ALIGNMENT * FrozenHull::ALIGNMENT;
+}
+
+FrozenHull::FrozenHull(const DCEL3D& i_Hull) :
+    m_NbVertices(0),
+    m_NbFacets(0),
+    m_NbHalfEdges(0),
+    m_Center(0, 0, 0),
+    m_Vertices(NULL),
+    m_Planes(NULL),
+    m_FacetStarts(NULL),
+    m_Origins(NULL),
+    m_Twins(NULL),
+    m_BlockSize(0)
+{
+    // Number vertices by first appearance, and half-edges facet by facet from
+    // m_AnEdge, so that a twin is found from the index of its facet
+    std::vector<const Facet*> facets;
+    std::vector<const Point*> vertices;
+    std::vector<uint> firstHalfEdgeOfID(i_Hull.m_Facets.size());
+    std::unordered_map<const Point*, uint> vertexOfPt;
+    vertexOfPt.reserve(i_Hull.m_Facets.size());
+    bool areTriangles(true);
+    for (const sptr<Facet>& facet : i_Hull.m_Facets) {
+        if (!facet) {
+            continue;
+        }
+        facets.push_back(facet.get());
+        firstHalfEdgeOfID[facet->m_ID] = m_NbHalfEdges;
+        uint nbEdges(0);
+        const HalfEdge* edge(facet->m_AnEdge.get());
+        do {
+            const Point* pt(edge->m_Origin.get());
+            if (vertexOfPt.emplace(pt, vertices.size()).second) {
+                vertices.push_back(pt);
+                m_Center += Vector(*pt);
+            }
+            ++nbEdges;
+            edge = edge->m_Next.get();
+        } while (edge != facet->m_AnEdge.get());
+        m_NbHalfEdges += nbEdges;
+        areTriangles = areTriangles && nbEdges == 3;
+    }
+    m_NbVertices = vertices.size();
+    m_NbFacets = facets.size();
+    m_Center /= (std::max)(1u, m_NbVertices);
+
+    // One block, each array on its own cache lines
+    size_t verticesAt(0);
+    size_t planesAt(verticesAt + alignUp(3 * sizeof(double) * m_NbVertices));
+    size_t facetStartsAt(planesAt + alignUp(4 * sizeof(float) * m_NbFacets));
+    size_t originsAt(facetStartsAt + (areTriangles ? 0 : alignUp(sizeof(uint) * (m_NbFacets + 1))));
+    size_t twinsAt(originsAt + alignUp(sizeof(uint) * m_NbHalfEdges));
+    m_BlockSize = twinsAt + alignUp(sizeof(uint) * m_NbHalfEdges);
+
+    m_Block.reset(new char[m_BlockSize + ALIGNMENT - 1]);
+    char* start(m_Block.get() + (ALIGNMENT - uintptr_t(m_Block.get()) % ALIGNMENT) % ALIGNMENT);
+    double* vertexCoordinates((double*)(start + verticesAt));
+    float* planes((float*)(start + planesAt));
+    uint* facetStarts(areTriangles ? NULL : (uint*)(start + facetStartsAt));
+    uint* origins((uint*)(start + originsAt));
+    uint* twins((uint*)(start + twinsAt));
+
+    for (uint i = 0; i < m_NbVertices; ++i) {
+        vertexCoordinates[3 * i] = vertices[i]->m_x;
+        vertexCoordinates[3 * i + 1] = vertices[i]->m_y;
+        vertexCoordinates[3 * i + 2] = vertices[i]->m_z;
+    }
+
+    uint halfEdge(0);
+    for (uint i = 0; i < m_NbFacets; ++i) {
+        const Facet* facet(facets[i]);
+        Vector normal(facet->m_Normal.normalize());
+        planes[4 * i] = float(normal.m_x);
+        planes[4 * i + 1] = float(normal.m_y);
+        planes[4 * i + 2] = float(normal.m_z);
+        planes[4 * i + 3] = float(-dot(normal, *facet->m_AnEdge->m_Origin - m_Center));
+
+        if (facetStarts) {
+            facetStarts[i] = halfEdge;
+        }
+        const HalfEdge* edge(facet->m_AnEdge.get());
+        do {
+            origins[halfEdge] = vertexOfPt[edge->m_Origin.get()];
+            const HalfEdge* twin(edge->m_Twin.get());
+            const Facet* twinFacet(twin->m_Facet.get());
+            twins[halfEdge] = firstHalfEdgeOfID[twinFacet->m_ID];
+            for (const HalfEdge* other = twinFacet->m_AnEdge.get(); other != twin; other = other->m_Next.get()) {
+                ++twins[halfEdge];
+            }
+            ++halfEdge;
+            edge = edge->m_Next.get();
+        } while (edge != facet->m_AnEdge.get());
+    }
+    if (facetStarts) {
+        facetStarts[m_NbFacets] = halfEdge;
+    }
+
+    m_Vertices = vertexCoordinates;
+    m_Planes = planes;
+    m_FacetStarts = facetStarts;
+    m_Origins = origins;
+    m_Twins = twins;
+}
+
+uint FrozenHull::facetOf(uint i_HalfEdge) const
+{
+    if (!m_FacetStarts) {
+        return TriangleMesh::facetOf(i_HalfEdge);
+    }
+    return std::upper_bound(m_FacetStarts, m_FacetStarts + m_NbFacets + 1, i_HalfEdge) - m_FacetStarts - 1;
+}
+
+uint FrozenHull::next(uint i_HalfEdge) const
+{
+    if (!m_FacetStarts) {
+        return TriangleMesh::next(i_HalfEdge);
+    }
+    uint facet(facetOf(i_HalfEdge));
+    return i_HalfEdge + 1 == facetEnd(facet) ? facetStart(facet) : i_HalfEdge + 1;
+}
+
+double FrozenHull::signedDistance(uint i_Facet, const Point& i_Pt) const
+{
+    const float* plane(m_Planes + 4 * i_Facet);
+    Vector pt(i_Pt - m_Center);
+    return plane[0] * pt.m_x + plane[1] * pt.m_y + plane[2] * pt.m_z + plane[3];
+}
+
+double FrozenHull::maxSignedDistance(const Point& i_Pt) const
+{
+    double x(i_Pt.m_x - m_Center.m_x), y(i_Pt.m_y - m_Center.m_y), z(i_Pt.m_z - m_Center.m_z);
+    double distance(-std::numeric_limits<double>::max());
+    for (uint i = 0; i < m_NbFacets; ++i) {
+        const float* plane(m_Planes + 4 * i);
+        distance = (std::max)(distance, plane[0] * x + plane[1] * y + plane[2] * z + plane[3]);
+    }
+    return distance;
+}
\ No newline at end of file
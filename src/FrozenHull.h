@@ -0,0 +1,64 @@
+#ifndef __FrozenHull__
+#define __FrozenHull__
+
+#include <memory>
+
+#include "DCEL3D.h"
+
+// Immutable copy of a built hull for query serving. Vertices, facet planes
+// and half-edges are index arrays in a single block, each starting on a
+// 64-byte boundary, with no pointer or reference count between them: nothing
+// is written after construction, so reader threads can share it (through a
+// sptr<const FrozenHull>) without synchronization.
+//
+// Half-edges of facet f are facetStart(f) to facetEnd(f) (excluded) in
+// counterclockwise order seen from outside. When every facet is a triangle,
+// m_FacetStarts is NULL and they are 3f to 3f + 2, as in TriangleMesh.
+// Planes are float unit normals and offsets relative to m_Center (their
+// error is about 1e-7 of the hull size), so a triangulated hull takes about
+// 104 bytes per vertex.
+struct FrozenHull
+{
+    static const uint ALIGNMENT = 64;
+
+    uint          m_NbVertices;
+    uint          m_NbFacets;
+    uint          m_NbHalfEdges;
+    Point         m_Center;          // Average of the vertices
+
+    const double* m_Vertices;        // x, y, z per vertex
+    const float*  m_Planes;          // Normal x, y, z and offset per facet
+    const uint*   m_FacetStarts;     // m_NbFacets + 1 entries, or NULL
+    const uint*   m_Origins;         // Vertex each half-edge starts from
+    const uint*   m_Twins;           // Opposite half-edge
+
+    std::unique_ptr<char[]> m_Block;
+    size_t        m_BlockSize;       // Bytes used from the aligned start
+
+    FrozenHull(const DCEL3D& i_Hull);
+
+    Point vertex(uint i_Vertex) const
+    {
+        const double* xyz(m_Vertices + 3 * i_Vertex);
+        return Point(xyz[0], xyz[1], xyz[2]);
+    }
+
+    uint facetStart(uint i_Facet) const { return m_FacetStarts ? m_FacetStarts[i_Facet] : 3 * i_Facet; }
+    uint facetEnd(uint i_Facet) const { return facetStart(i_Facet + 1); }
+
+    // O(1) for triangles, O(log F) otherwise
+    uint facetOf(uint i_HalfEdge) const;
+
+    uint next(uint i_HalfEdge) const;
+    uint target(uint i_HalfEdge) const { return m_Origins[next(i_HalfEdge)]; }
+
+    // Positive outside the facet plane
+    double signedDistance(uint i_Facet, const Point& i_Pt) const;
+
+    // Largest signed distance to a facet plane: positive outside the hull
+    double maxSignedDistance(const Point& i_Pt) const;
+
+    size_t memoryUsage() const { return sizeof(FrozenHull) + m_BlockSize + ALIGNMENT - 1; }
+};
+
+#endif
\ No newline at end of file
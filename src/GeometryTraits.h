@@ -0,0 +1,151 @@
+#ifndef __GeometryTraits__
+#define __GeometryTraits__
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "ExactPredicates.h"
+#include "Int128.h"
+#include "Point.h"
+
+// Plane representation and orientation predicates used by the engines for a
+// given coordinate type. Float coordinates are promoted to double before any
+// computation, so float storage halves the size of the points without losing
+// the accuracy of the double predicates.
+//
+// Double predicates are filtered: the sign of a point's signed offset from a
+// plane is the sign of the rounded value when it exceeds a bound on the
+// rounding error of the normal and of both dot products (see
+// computeTolerance), and is computed exactly from the points that define the
+// plane otherwise (see computeOrientation). The engine never sees a sign that
+// rounding could have flipped.
+template <typename Scalar>
+struct GeometryTraits
+{
+    typedef TPoint<double>  Promoted;
+    typedef TVector<double> Normal;
+    typedef double          Offset;
+
+    static Normal computeNormal(const TPoint<Scalar>& i_A, const TPoint<Scalar>& i_B, 
+                                const TPoint<Scalar>& i_C)
+    {
+        Promoted a(i_A);
+        return cross(Promoted(i_B) - a, Promoted(i_C) - a);
+    }
+
+    static Offset computeOffset(const Normal& i_Normal, const TPoint<Scalar>& i_Pt)
+    {
+        return i_Normal.m_x * double(i_Pt.m_x) + 
+               i_Normal.m_y * double(i_Pt.m_y) + 
+               i_Normal.m_z * double(i_Pt.m_z);
+    }
+
+    // Error bound on computeOffset(normal, pt) - offset for planes and points
+    // of an input whose coordinates are within i_MaxCoord of the origin and
+    // i_Extent of each other. Normal components are within 8 eps extent^2 of
+    // their exact value, and are at most 2 extent^2.
+    static Offset computeTolerance(double i_MaxCoord, double i_Extent)
+    {
+        return 32 * std::numeric_limits<double>::epsilon() * i_Extent * i_Extent * (i_Extent + i_MaxCoord);
+    }
+
+    // Same, from the bounding box of the input
+    static Offset computeTolerance(const Point& i_Min, const Point& i_Max)
+    {
+        double maxCoord(0), extent(0);
+        for (int axis = 0; axis < 3; ++axis) {
+            maxCoord = (std::max)(maxCoord, (std::max)(fabs(i_Min[axis]), fabs(i_Max[axis])));
+            extent = (std::max)(extent, i_Max[axis] - i_Min[axis]);
+        }
+        return computeTolerance(maxCoord, extent);
+    }
+
+    // Exact sign of the offset of i_D from the plane of i_A, i_B and i_C
+    static int computeOrientation(const TPoint<Scalar>& i_A, const TPoint<Scalar>& i_B, 
+                                  const TPoint<Scalar>& i_C, const TPoint<Scalar>& i_D)
+    {
+        return computeExactOrientation(Point(i_A), Point(i_B), Point(i_C), Point(i_D));
+    }
+
+    // Is the point within the tolerance of the plane
+    static bool isOnPlane(const Normal& i_Normal, Offset i_Offset, const TPoint<Scalar>& i_Pt, Offset i_Tolerance)
+    {
+        return fabs(computeOffset(i_Normal, i_Pt) - i_Offset) <= i_Tolerance;
+    }
+};
+
+// Integer coordinates must stay within +/- MAX_GRID_COORD so that normals fit
+// in 64 bits and plane equations in 128 bits
+#define MAX_GRID_COORD (1 << 29)
+
+struct IntegerNormal
+{
+    long long m_x;
+    long long m_y;
+    long long m_z;
+
+    bool isNull() const { return m_x == 0 && m_y == 0 && m_z == 0; }
+};
+
+// Exact predicates on integer coordinates, without any epsilon
+template <>
+struct GeometryTraits<int>
+{
+    typedef IntegerNormal Normal;
+    typedef Int128        Offset;
+
+    static Normal computeNormal(const TPoint<int>& i_A, const TPoint<int>& i_B, const TPoint<int>& i_C)
+    {
+        long long ux((long long)i_B.m_x - i_A.m_x), uy((long long)i_B.m_y - i_A.m_y), uz((long long)i_B.m_z - i_A.m_z);
+        long long vx((long long)i_C.m_x - i_A.m_x), vy((long long)i_C.m_y - i_A.m_y), vz((long long)i_C.m_z - i_A.m_z);
+        Normal normal = { uy * vz - uz * vy, uz * vx - ux * vz, ux * vy - uy * vx };
+        return normal;
+    }
+
+    static Offset computeOffset(const Normal& i_Normal, const TPoint<int>& i_Pt)
+    {
+        return mul128(i_Normal.m_x, i_Pt.m_x) + 
+               mul128(i_Normal.m_y, i_Pt.m_y) + 
+               mul128(i_Normal.m_z, i_Pt.m_z);
+    }
+
+    // Exact, so no tolerance
+    static Offset computeTolerance(double, double)
+    {
+        return Offset();
+    }
+
+    static Offset computeTolerance(const Point&, const Point&)
+    {
+        return Offset();
+    }
+
+    static int computeOrientation(const TPoint<int>& i_A, const TPoint<int>& i_B, 
+                                  const TPoint<int>& i_C, const TPoint<int>& i_D)
+    {
+        Normal normal(computeNormal(i_A, i_B, i_C));
+        Offset offset(computeOffset(normal, i_A)), offsetOfD(computeOffset(normal, i_D));
+        return offsetOfD > offset ? 1 : offsetOfD < offset ? -1 : 0;
+    }
+
+    // Facet::isCoplanarWith
+    static bool isOnPlane(const Normal& i_Normal, Offset i_Offset, const TPoint<int>& i_Pt, Offset = Offset())
+    {
+        return computeOffset(i_Normal, i_Pt) == i_Offset;
+    }
+};
+
+inline bool areCollinear(const TPoint<int>& i_A, const TPoint<int>& i_B, const TPoint<int>& i_C)
+{
+    return GeometryTraits<int>::computeNormal(i_A, i_B, i_C).isNull();
+}
+
+inline bool areCoplanar(const TPoint<int>& i_A, const TPoint<int>& i_B, const TPoint<int>& i_C, 
+                        const TPoint<int>& i_D)
+{
+    GeometryTraits<int>::Normal normal(GeometryTraits<int>::computeNormal(i_A, i_B, i_C));
+    return GeometryTraits<int>::isOnPlane(normal, GeometryTraits<int>::computeOffset(normal, i_A), i_D);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <limits>
+
+#include "HullClassifier.h"
+#include "Parallel.h"
+
+HullClassifier::HullClassifier(const DCEL3D& i_Hull, double i_Tolerance) :
+    m_NbFacets(0),
+    m_Min(std::numeric_limits<double>::max()),
+    m_Max(-std::numeric_limits<double>::max()),
+    m_Center(0, 0, 0),
+    m_InnerRadius(0),
+    m_Tolerance(i_Tolerance)
+{
+    // Larger facets first: they are the most likely to reject a point
+    std::vector<sptr<Facet>> facets;
+    for (const sptr<Facet>& facet : i_Hull.m_Facets) {
+        if (facet) {
+            facets.push_back(facet);
+        }
+    }
+    std::sort(facets.begin(), facets.end(), [](const sptr<Facet>& i_A, const sptr<Facet>& i_B) {
+        return i_A->m_Normal.squareNorm() > i_B->m_Normal.squareNorm();
+    });
+
+    // Planes, bounding box and vertex average (inside the hull)
+    uint nbVertices(0);
+    for (const sptr<Facet>& facet : facets) {
+
+        Vector normal(facet->m_Normal.normalize());
+        m_NormalsX.push_back(normal.m_x);
+        m_NormalsY.push_back(normal.m_y);
+        m_NormalsZ.push_back(normal.m_z);
+        m_Offsets.push_back(-dot(normal, *facet->m_AnEdge->m_Origin));
+        ++m_NbFacets;
+
+        sptr<HalfEdge> edge(facet->m_AnEdge);
+        do {
+            const Point& pt(*edge->m_Origin);
+            for (int axis = 0; axis < 3; ++axis) {
+                m_Min[axis] = (std::min)(m_Min[axis], pt[axis]);
+                m_Max[axis] = (std::max)(m_Max[axis], pt[axis]);
+            }
+            m_Center += Vector(pt);
+            ++nbVertices;
+            edge = edge->m_Next;
+        } while (edge != facet->m_AnEdge);
+    }
+    m_Center /= (std::max)(1u, nbVertices);
+
+    // Largest sphere around the center that is inside every plane
+    m_InnerRadius = std::numeric_limits<double>::max();
+    for (uint i = 0; i < m_NbFacets; ++i) {
+        double distance(-(m_NormalsX[i] * m_Center.m_x + m_NormalsY[i] * m_Center.m_y + 
+                          m_NormalsZ[i] * m_Center.m_z + m_Offsets[i]));
+        m_InnerRadius = (std::min)(m_InnerRadius, distance);
+    }
+    m_InnerRadius = (std::max)(0.0, m_InnerRadius);
+
+    // Pad with planes that every point is far inside of
+    uint nbPlanes((m_NbFacets + PLANE_BLOCK - 1) / PLANE_BLOCK * PLANE_BLOCK);
+    m_NormalsX.resize(nbPlanes, 0);
+    m_NormalsY.resize(nbPlanes, 0);
+    m_NormalsZ.resize(nbPlanes, 0);
+    m_Offsets.resize(nbPlanes, -std::numeric_limits<double>::max());
+}
+
+PointLocation HullClassifier::classify(const Point& i_Pt) const
+{
+    // Outside the bounding box
+    if (i_Pt.m_x < m_Min.m_x - m_Tolerance || i_Pt.m_x > m_Max.m_x + m_Tolerance ||
+        i_Pt.m_y < m_Min.m_y - m_Tolerance || i_Pt.m_y > m_Max.m_y + m_Tolerance ||
+        i_Pt.m_z < m_Min.m_z - m_Tolerance || i_Pt.m_z > m_Max.m_z + m_Tolerance) {
+        return OUTSIDE;
+    }
+
+    // Inside the inscribed sphere
+    double innerRadius(m_InnerRadius - m_Tolerance);
+    if (innerRadius > 0 && squareDistance(i_Pt, m_Center) < innerRadius * innerRadius) {
+        return INSIDE;
+    }
+
+    // Largest signed distance to a plane, one block at a time. Each lane keeps
+    // its own maximum so that the block loop vectorizes.
+    double maxDistances[PLANE_BLOCK];
+    for (uint i = 0; i < PLANE_BLOCK; ++i) {
+        maxDistances[i] = -std::numeric_limits<double>::max();
+    }
+    double maxDistance(-std::numeric_limits<double>::max());
+    for (uint block = 0; block < m_Offsets.size(); block += PLANE_BLOCK) {
+        const double* normalsX(&m_NormalsX[block]);
+        const double* normalsY(&m_NormalsY[block]);
+        const double* normalsZ(&m_NormalsZ[block]);
+        const double* offsets(&m_Offsets[block]);
+        for (uint i = 0; i < PLANE_BLOCK; ++i) {
+            double distance(normalsX[i] * i_Pt.m_x + normalsY[i] * i_Pt.m_y + 
+                            normalsZ[i] * i_Pt.m_z + offsets[i]);
+            maxDistances[i] = distance > maxDistances[i] ? distance : maxDistances[i];
+        }
+
+        maxDistance = maxDistances[0];
+        for (uint i = 1; i < PLANE_BLOCK; ++i) {
+            maxDistance = maxDistances[i] > maxDistance ? maxDistances[i] : maxDistance;
+        }
+        if (maxDistance > m_Tolerance) {
+            return OUTSIDE;
+        }
+    }
+
+    return maxDistance < -m_Tolerance ? INSIDE : ON_HULL;
+}
+
+void HullClassifier::classify(const Point* i_Pts, uint i_NbPts, unsigned char* o_Locations) const
+{
+    parallelFor(0, i_NbPts, [&](uint, uint i_Begin, uint i_End) {
+        for (uint i = i_Begin; i < i_End; ++i) {
+            o_Locations[i] = (unsigned char)classify(i_Pts[i]);
+        }
+    });
+}
+
+void HullClassifier::classify(const std::vector<sPoint>& i_Pts, unsigned char* o_Locations) const
+{
+    parallelFor(0, i_Pts.size(), [&](uint, uint i_Begin, uint i_End) {
+        for (uint i = i_Begin; i < i_End; ++i) {
+            o_Locations[i] = (unsigned char)classify(*i_Pts[i]);
+        }
+    });
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef __HullClassifier__
+#define __HullClassifier__
+
+#include <vector>
+
+#include "DCEL3D.h"
+
+enum PointLocation { INSIDE, ON_HULL, OUTSIDE };
+
+// Point-in-hull queries against a built hull. Facet planes are stored once as
+// unit normals and offsets in separate arrays (padded to a multiple of
+// PLANE_BLOCK), so a point is tested against a block of planes with one
+// vectorizable loop and rejected as soon as a block has a positive distance.
+// Points outside the bounding box or inside the inscribed sphere are decided
+// without looking at the planes.
+struct HullClassifier
+{
+    static const uint PLANE_BLOCK = 8;
+
+    std::vector<double> m_NormalsX;
+    std::vector<double> m_NormalsY;
+    std::vector<double> m_NormalsZ;
+    std::vector<double> m_Offsets;     // Signed distance is dot(normal, pt) + offset
+    uint                m_NbFacets;
+
+    Point               m_Min;
+    Point               m_Max;
+    Point               m_Center;
+    double              m_InnerRadius;
+
+    // Points within i_Tolerance of the boundary are ON_HULL
+    double              m_Tolerance;
+
+    HullClassifier(const DCEL3D& i_Hull, double i_Tolerance = EPSILON);
+
+    PointLocation classify(const Point& i_Pt) const;
+
+    // Classifies points in parallel, one PointLocation per byte
+    void classify(const Point* i_Pts, uint i_NbPts, unsigned char* o_Locations) const;
+    void classify(const std::vector<sPoint>& i_Pts, unsigned char* o_Locations) const;
+};
+
+#endif
\ No newline at end of file
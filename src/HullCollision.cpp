@@ -0,0 +1,542 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "HullCollision.h"
+#include "Parallel.h"
+
+// GJK stops when an iteration brings v closer to the origin by less than
+// this fraction, and reports contact when |v| is below this fraction of the
+// size of the difference
+#define GJK_TOLERANCE 1e-10
+#define GJK_MAX_ITERATIONS 64
+
+// EPA stops when the closest face is within this fraction of the size of the
+// difference from the true boundary
+#define EPA_TOLERANCE 1e-9
+#define EPA_MAX_ITERATIONS 128
+
+/************************************************************************/
+/*                            HullInstance                              */
+/************************************************************************/
+
+HullInstance::HullInstance(const HullSupport* i_Hull) :
+    m_Hull(i_Hull),
+    m_Rotation{1, 0, 0, 0, 1, 0, 0, 0, 1},
+    m_Translation(0, 0, 0)
+{}
+
+Point HullInstance::vertex(uint i_Index) const
+{
+    const Point& pt(m_Hull->m_Points[i_Index]);
+    const double* r(m_Rotation);
+    return Point(r[0] * pt.m_x + r[1] * pt.m_y + r[2] * pt.m_z + m_Translation.m_x,
+                 r[3] * pt.m_x + r[4] * pt.m_y + r[5] * pt.m_z + m_Translation.m_y,
+                 r[6] * pt.m_x + r[7] * pt.m_y + r[8] * pt.m_z + m_Translation.m_z);
+}
+
+Point HullInstance::support(const Vector& i_Direction, uint& io_Hint) const
+{
+    // Direction in the hull frame is the transposed rotation of the world one
+    const double* r(m_Rotation);
+    Vector local(r[0] * i_Direction.m_x + r[3] * i_Direction.m_y + r[6] * i_Direction.m_z,
+                 r[1] * i_Direction.m_x + r[4] * i_Direction.m_y + r[7] * i_Direction.m_z,
+                 r[2] * i_Direction.m_x + r[5] * i_Direction.m_y + r[8] * i_Direction.m_z);
+    return vertex(m_Hull->support(local, io_Hint));
+}
+
+ProximityCache::ProximityCache() :
+    m_Axis(1, 0, 0),
+    m_HintA(0),
+    m_HintB(0),
+    m_IsValid(false)
+{}
+
+/************************************************************************/
+/*                               Simplex                                */
+/************************************************************************/
+
+// Point of the Minkowski difference A - B, with the hull points it comes from
+struct SimplexVertex
+{
+    Vector m_W;
+    Point  m_A;
+    Point  m_B;
+};
+
+// Closest point to the origin is the sum of the weighted vertices
+struct Simplex
+{
+    SimplexVertex m_Vertices[4];
+    double        m_Weights[4];
+    uint          m_Size;
+};
+
+static SimplexVertex supportOfDifference(const HullInstance& i_A, const HullInstance& i_B,
+                                         const Vector& i_Direction, ProximityCache& io_Cache)
+{
+    SimplexVertex vertex;
+    vertex.m_A = i_A.support(i_Direction, io_Cache.m_HintA);
+    vertex.m_B = i_B.support(-i_Direction, io_Cache.m_HintB);
+    vertex.m_W = vertex.m_A - vertex.m_B;
+    return vertex;
+}
+
+static Point combine(const Point& i_P0, const Point& i_P1, const Point& i_P2,
+                     double i_W0, double i_W1, double i_W2)
+{
+    return Point(i_W0 * i_P0.m_x + i_W1 * i_P1.m_x + i_W2 * i_P2.m_x,
+                 i_W0 * i_P0.m_y + i_W1 * i_P1.m_y + i_W2 * i_P2.m_y,
+                 i_W0 * i_P0.m_z + i_W1 * i_P1.m_z + i_W2 * i_P2.m_z);
+}
+
+// Closest point of segment ab to the origin, as the vertices it lies on and
+// their weights. Returns the number of vertices kept.
+static uint closestOnSegment(const Vector& i_A, const Vector& i_B, uint* o_Kept, double* o_Weights)
+{
+    Vector ab(i_B - i_A);
+    double t(-dot(i_A, ab));
+    double squareLength(ab.squareNorm());
+    if (t <= 0 || squareLength == 0) {
+        o_Kept[0] = 0;
+        o_Weights[0] = 1;
+        return 1;
+    }
+    if (t >= squareLength) {
+        o_Kept[0] = 1;
+        o_Weights[0] = 1;
+        return 1;
+    }
+    t /= squareLength;
+    o_Kept[0] = 0;
+    o_Kept[1] = 1;
+    o_Weights[0] = 1 - t;
+    o_Weights[1] = t;
+    return 2;
+}
+
+// Same for triangle abc, walking its Voronoi regions (Ericson, Real-Time
+// Collision Detection, 5.1.5)
+static uint closestOnTriangle(const Vector& i_A, const Vector& i_B, const Vector& i_C,
+                              uint* o_Kept, double* o_Weights)
+{
+    Vector ab(i_B - i_A);
+    Vector ac(i_C - i_A);
+
+    double d1(-dot(ab, i_A));
+    double d2(-dot(ac, i_A));
+    if (d1 <= 0 && d2 <= 0) {
+        o_Kept[0] = 0;
+        o_Weights[0] = 1;
+        return 1;
+    }
+
+    double d3(-dot(ab, i_B));
+    double d4(-dot(ac, i_B));
+    if (d3 >= 0 && d4 <= d3) {
+        o_Kept[0] = 1;
+        o_Weights[0] = 1;
+        return 1;
+    }
+
+    double vc(d1 * d4 - d3 * d2);
+    if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+        double t(d1 / (d1 - d3));
+        o_Kept[0] = 0;
+        o_Kept[1] = 1;
+        o_Weights[0] = 1 - t;
+        o_Weights[1] = t;
+        return 2;
+    }
+
+    double d5(-dot(ab, i_C));
+    double d6(-dot(ac, i_C));
+    if (d6 >= 0 && d5 <= d6) {
+        o_Kept[0] = 2;
+        o_Weights[0] = 1;
+        return 1;
+    }
+
+    double vb(d5 * d2 - d1 * d6);
+    if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+        double t(d2 / (d2 - d6));
+        o_Kept[0] = 0;
+        o_Kept[1] = 2;
+        o_Weights[0] = 1 - t;
+        o_Weights[1] = t;
+        return 2;
+    }
+
+    double va(d3 * d6 - d5 * d4);
+    if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0) {
+        double t((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+        o_Kept[0] = 1;
+        o_Kept[1] = 2;
+        o_Weights[0] = 1 - t;
+        o_Weights[1] = t;
+        return 2;
+    }
+
+    double sum(va + vb + vc);
+    if (sum == 0) {
+        // Degenerate triangle, its closest point is on the longest edge
+        const Vector* corners[3] = {&i_A, &i_B, &i_C};
+        uint from(0), to(ac.squareNorm() > ab.squareNorm() ? 2 : 1);
+        if ((i_C - i_B).squareNorm() > (std::max)(ab.squareNorm(), ac.squareNorm())) {
+            from = 1;
+            to = 2;
+        }
+        uint nbKept(closestOnSegment(*corners[from], *corners[to], o_Kept, o_Weights));
+        for (uint i = 0; i < nbKept; ++i) {
+            o_Kept[i] = o_Kept[i] == 0 ? from : to;
+        }
+        return nbKept;
+    }
+    o_Kept[0] = 0;
+    o_Kept[1] = 1;
+    o_Kept[2] = 2;
+    o_Weights[1] = vb / sum;
+    o_Weights[2] = vc / sum;
+    o_Weights[0] = 1 - o_Weights[1] - o_Weights[2];
+    return 3;
+}
+
+// Faces of a tetrahedron, with the opposite vertex
+static const uint s_TetrahedronFaces[4][4] = {{0, 1, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {1, 3, 2, 0}};
+
+// Same for tetrahedron abcd. Returns 0 when the origin is inside.
+static uint closestOnTetrahedron(const Simplex& i_Simplex, uint* o_Kept, double* o_Weights)
+{
+    double bestSquareDistance(std::numeric_limits<double>::max());
+    uint nbKept(0);
+
+    // Only faces that have the origin on their outer side can hold the closest
+    // point (flat faces are always tried)
+    for (const uint* face : s_TetrahedronFaces) {
+        const Vector& a(i_Simplex.m_Vertices[face[0]].m_W);
+        const Vector& b(i_Simplex.m_Vertices[face[1]].m_W);
+        const Vector& c(i_Simplex.m_Vertices[face[2]].m_W);
+        const Vector& d(i_Simplex.m_Vertices[face[3]].m_W);
+        Vector normal(cross(b - a, c - a));
+        if (-dot(normal, a) * dot(normal, d - a) > 0) {
+            continue;
+        }
+
+        uint kept[3];
+        double weights[3];
+        uint nbFaceKept(closestOnTriangle(a, b, c, kept, weights));
+        Vector closest(0, 0, 0);
+        for (uint i = 0; i < nbFaceKept; ++i) {
+            closest += i_Simplex.m_Vertices[face[kept[i]]].m_W * weights[i];
+        }
+        if (closest.squareNorm() < bestSquareDistance) {
+            bestSquareDistance = closest.squareNorm();
+            nbKept = nbFaceKept;
+            for (uint i = 0; i < nbFaceKept; ++i) {
+                o_Kept[i] = face[kept[i]];
+                o_Weights[i] = weights[i];
+            }
+        }
+    }
+    return nbKept;
+}
+
+// Reduces the simplex to the smallest sub-simplex holding its closest point
+// to the origin, and returns that point in o_Closest. Returns false when the
+// simplex encloses the origin.
+static bool updateSimplex(Simplex& io_Simplex, Vector& o_Closest)
+{
+    const SimplexVertex* vertices(io_Simplex.m_Vertices);
+    uint kept[4] = {0, 1, 2, 3};
+    double weights[4] = {1, 0, 0, 0};
+    uint nbKept(1);
+
+    if (io_Simplex.m_Size == 2) {
+        nbKept = closestOnSegment(vertices[0].m_W, vertices[1].m_W, kept, weights);
+    }
+    else if (io_Simplex.m_Size == 3) {
+        nbKept = closestOnTriangle(vertices[0].m_W, vertices[1].m_W, vertices[2].m_W, kept, weights);
+    }
+    else if (io_Simplex.m_Size == 4) {
+        nbKept = closestOnTetrahedron(io_Simplex, kept, weights);
+        if (nbKept == 0) {
+            return false;
+        }
+    }
+
+    SimplexVertex reduced[3];
+    o_Closest = Vector(0, 0, 0);
+    for (uint i = 0; i < nbKept; ++i) {
+        reduced[i] = vertices[kept[i]];
+        o_Closest += reduced[i].m_W * weights[i];
+    }
+    for (uint i = 0; i < nbKept; ++i) {
+        io_Simplex.m_Vertices[i] = reduced[i];
+        io_Simplex.m_Weights[i] = weights[i];
+    }
+    io_Simplex.m_Size = nbKept;
+    return true;
+}
+
+/************************************************************************/
+/*                                 GJK                                  */
+/************************************************************************/
+
+enum GJKOutcome { SEPARATED, TOUCHING, ENCLOSED };
+
+// Moves v, the closest point of a simplex of A - B to the origin, towards the
+// closest point of A - B. With i_StopAtSeparatingAxis, stops as soon as v is
+// a separating axis.
+static GJKOutcome runGJK(const HullInstance& i_A, const HullInstance& i_B, ProximityCache& io_Cache,
+                         bool i_StopAtSeparatingAxis, Simplex& o_Simplex, Vector& o_Closest)
+{
+    // Warm start from the previous axis, or from any pair of vertices
+    Vector v(io_Cache.m_IsValid ? -io_Cache.m_Axis :
+             i_A.vertex(io_Cache.m_HintA) - i_B.vertex(io_Cache.m_HintB));
+    if (v.squareNorm() == 0) {
+        v = Vector(1, 0, 0);
+    }
+
+    o_Simplex.m_Size = 0;
+    double maxSquareNorm(0);
+    GJKOutcome outcome(SEPARATED);
+    for (uint iteration = 0; iteration < GJK_MAX_ITERATIONS; ++iteration) {
+
+        SimplexVertex w(supportOfDifference(i_A, i_B, -v, io_Cache));
+        double vv(dot(v, v));
+        double vw(dot(v, w.m_W));
+
+        // All of A - B is on the positive side of the plane through w
+        // orthogonal to v, which does not contain the origin
+        if (i_StopAtSeparatingAxis && vw > 0) {
+            break;
+        }
+
+        // No progress: v is the closest point
+        if (o_Simplex.m_Size > 0 && vv - vw <= GJK_TOLERANCE * vv) {
+            break;
+        }
+        bool isDuplicate(false);
+        for (uint i = 0; i < o_Simplex.m_Size; ++i) {
+            isDuplicate |= o_Simplex.m_Vertices[i].m_W.m_x == w.m_W.m_x &&
+                           o_Simplex.m_Vertices[i].m_W.m_y == w.m_W.m_y &&
+                           o_Simplex.m_Vertices[i].m_W.m_z == w.m_W.m_z;
+        }
+        if (isDuplicate) {
+            break;
+        }
+
+        o_Simplex.m_Vertices[o_Simplex.m_Size++] = w;
+        maxSquareNorm = (std::max)(maxSquareNorm, w.m_W.squareNorm());
+        if (!updateSimplex(o_Simplex, v)) {
+            outcome = ENCLOSED;
+            break;
+        }
+        if (v.squareNorm() <= GJK_TOLERANCE * GJK_TOLERANCE * maxSquareNorm) {
+            outcome = TOUCHING;
+            break;
+        }
+    }
+
+    // Keep the axis for the next query on this pair
+    if (outcome == SEPARATED) {
+        io_Cache.m_Axis = -v.normalize();
+        io_Cache.m_IsValid = true;
+    }
+    o_Closest = v;
+    return outcome;
+}
+
+/************************************************************************/
+/*                                 EPA                                  */
+/************************************************************************/
+
+struct EPAFace
+{
+    uint   m_Vertices[3];
+    Vector m_Normal;
+    double m_Distance;
+    bool   m_IsRemoved;
+};
+
+// Grows the polytope of A - B from the tetrahedron enclosing the origin found
+// by GJK, until its face closest to the origin is on the boundary of A - B
+static void runEPA(const HullInstance& i_A, const HullInstance& i_B, ProximityCache& io_Cache,
+                   const Simplex& i_Simplex, ProximityResult& o_Result)
+{
+    std::vector<SimplexVertex> vertices(i_Simplex.m_Vertices, i_Simplex.m_Vertices + 4);
+    std::vector<EPAFace> faces;
+    double scale(0);
+    for (const SimplexVertex& vertex : vertices) {
+        scale = (std::max)(scale, vertex.m_W.norm());
+    }
+
+    auto addFace = [&](uint i_A, uint i_B, uint i_C) {
+        EPAFace face = {{i_A, i_B, i_C}, Vector(0, 0, 0), std::numeric_limits<double>::max(), false};
+        Vector normal(cross(vertices[i_B].m_W - vertices[i_A].m_W, vertices[i_C].m_W - vertices[i_A].m_W));
+        double length(normal.norm());
+        // Degenerate faces are kept for the topology but never expanded
+        if (length > 0) {
+            face.m_Normal = normal / length;
+            face.m_Distance = dot(face.m_Normal, vertices[i_A].m_W);
+        }
+        faces.push_back(face);
+    };
+
+    // Outward faces of the tetrahedron
+    for (const uint* face : s_TetrahedronFaces) {
+        Vector normal(cross(vertices[face[1]].m_W - vertices[face[0]].m_W,
+                            vertices[face[2]].m_W - vertices[face[0]].m_W));
+        if (dot(normal, vertices[face[3]].m_W - vertices[face[0]].m_W) > 0) {
+            addFace(face[0], face[2], face[1]);
+        }
+        else {
+            addFace(face[0], face[1], face[2]);
+        }
+    }
+
+    std::vector<std::pair<uint, uint>> horizon;
+    uint closest(0);
+    for (uint iteration = 0; iteration < EPA_MAX_ITERATIONS; ++iteration) {
+
+        // Face closest to the origin
+        closest = uint(-1);
+        for (uint i = 0; i < faces.size(); ++i) {
+            if (!faces[i].m_IsRemoved && (closest == uint(-1) || faces[i].m_Distance < faces[closest].m_Distance)) {
+                closest = i;
+            }
+        }
+        const EPAFace& face(faces[closest]);
+
+        // Done when the boundary of A - B is not further in its direction
+        SimplexVertex w(supportOfDifference(i_A, i_B, face.m_Normal, io_Cache));
+        if (dot(face.m_Normal, w.m_W) - face.m_Distance <= EPA_TOLERANCE * scale) {
+            break;
+        }
+
+        // Remove the faces that see w, keeping the edges on their boundary
+        uint newVertex(vertices.size());
+        vertices.push_back(w);
+        horizon.clear();
+        for (EPAFace& otherFace : faces) {
+            if (otherFace.m_IsRemoved ||
+                dot(otherFace.m_Normal, w.m_W - vertices[otherFace.m_Vertices[0]].m_W) <= 0) {
+                continue;
+            }
+            otherFace.m_IsRemoved = true;
+            for (uint i = 0; i < 3; ++i) {
+                std::pair<uint, uint> edge(otherFace.m_Vertices[i], otherFace.m_Vertices[(i + 1) % 3]);
+                bool isShared(false);
+                for (uint j = 0; j < horizon.size() && !isShared; ++j) {
+                    if (horizon[j].first == edge.second && horizon[j].second == edge.first) {
+                        horizon[j] = horizon.back();
+                        horizon.pop_back();
+                        isShared = true;
+                    }
+                }
+                if (!isShared) {
+                    horizon.push_back(edge);
+                }
+            }
+        }
+        if (horizon.empty()) {
+            break;
+        }
+
+        // Cone from the horizon to w
+        for (const std::pair<uint, uint>& edge : horizon) {
+            addFace(edge.first, edge.second, newVertex);
+        }
+        scale = (std::max)(scale, w.m_W.norm());
+    }
+
+    // Deepest points from the projection of the origin on the closest face
+    const EPAFace& face(faces[closest]);
+    const SimplexVertex& a(vertices[face.m_Vertices[0]]);
+    const SimplexVertex& b(vertices[face.m_Vertices[1]]);
+    const SimplexVertex& c(vertices[face.m_Vertices[2]]);
+    Vector projection(face.m_Normal * face.m_Distance);
+    Vector normal(cross(b.m_W - a.m_W, c.m_W - a.m_W));
+    double wa(1), wb(0), wc(0);
+    if (normal.squareNorm() > 0) {
+        wa = dot(cross(b.m_W - projection, c.m_W - projection), normal) / normal.squareNorm();
+        wb = dot(cross(c.m_W - projection, a.m_W - projection), normal) / normal.squareNorm();
+        wc = 1 - wa - wb;
+    }
+
+    o_Result.m_IsOverlapping = true;
+    o_Result.m_Distance = -face.m_Distance;
+    o_Result.m_Axis = face.m_Normal;
+    o_Result.m_PointA = combine(a.m_A, b.m_A, c.m_A, wa, wb, wc);
+    o_Result.m_PointB = combine(a.m_B, b.m_B, c.m_B, wa, wb, wc);
+
+    io_Cache.m_Axis = face.m_Normal;
+    io_Cache.m_IsValid = true;
+}
+
+/************************************************************************/
+/*                               Queries                                */
+/************************************************************************/
+
+bool overlaps(const HullInstance& i_A, const HullInstance& i_B, ProximityCache& io_Cache)
+{
+    Simplex simplex;
+    Vector closest;
+    return runGJK(i_A, i_B, io_Cache, true, simplex, closest) != SEPARATED;
+}
+
+ProximityResult computeProximity(const HullInstance& i_A, const HullInstance& i_B,
+                                 ProximityCache& io_Cache)
+{
+    Simplex simplex;
+    Vector closest;
+    GJKOutcome outcome(runGJK(i_A, i_B, io_Cache, false, simplex, closest));
+
+    ProximityResult result;
+    if (outcome == ENCLOSED) {
+        runEPA(i_A, i_B, io_Cache, simplex, result);
+        return result;
+    }
+
+    const SimplexVertex* vertices(simplex.m_Vertices);
+    const double* weights(simplex.m_Weights);
+    double w1(simplex.m_Size > 1 ? weights[1] : 0);
+    double w2(simplex.m_Size > 2 ? weights[2] : 0);
+    uint i1(simplex.m_Size > 1 ? 1 : 0);
+    uint i2(simplex.m_Size > 2 ? 2 : 0);
+    result.m_PointA = combine(vertices[0].m_A, vertices[i1].m_A, vertices[i2].m_A, weights[0], w1, w2);
+    result.m_PointB = combine(vertices[0].m_B, vertices[i1].m_B, vertices[i2].m_B, weights[0], w1, w2);
+
+    // Touching hulls keep the last known axis
+    result.m_IsOverlapping = outcome == TOUCHING;
+    result.m_Distance = outcome == TOUCHING ? 0 : closest.norm();
+    result.m_Axis = io_Cache.m_Axis;
+    return result;
+}
+
+void overlaps(const std::vector<HullInstance>& i_Hulls,
+              const std::vector<std::pair<uint, uint>>& i_Pairs,
+              std::vector<ProximityCache>& io_Caches, std::vector<char>& o_Overlaps)
+{
+    io_Caches.resize(i_Pairs.size());
+    o_Overlaps.resize(i_Pairs.size());
+    parallelFor(0, i_Pairs.size(), [&](uint, uint i_Begin, uint i_End) {
+        for (uint i = i_Begin; i < i_End; ++i) {
+            o_Overlaps[i] = overlaps(i_Hulls[i_Pairs[i].first], i_Hulls[i_Pairs[i].second], io_Caches[i]);
+        }
+    });
+}
+
+void computeProximities(const std::vector<HullInstance>& i_Hulls,
+                        const std::vector<std::pair<uint, uint>>& i_Pairs,
+                        std::vector<ProximityCache>& io_Caches,
+                        std::vector<ProximityResult>& o_Results)
+{
+    io_Caches.resize(i_Pairs.size());
+    o_Results.resize(i_Pairs.size());
+    parallelFor(0, i_Pairs.size(), [&](uint, uint i_Begin, uint i_End) {
+        for (uint i = i_Begin; i < i_End; ++i) {
+            o_Results[i] = computeProximity(i_Hulls[i_Pairs[i].first], i_Hulls[i_Pairs[i].second], io_Caches[i]);
+        }
+    });
+}
\ No newline at end of file
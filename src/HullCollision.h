@@ -0,0 +1,67 @@
+#ifndef __HullCollision__
+#define __HullCollision__
+
+#include <vector>
+
+#include "HullSupport.h"
+
+// A built hull placed in the world by a rotation (row-major, local to world)
+// and a translation. The hull itself is shared, so moving an instance costs
+// nothing.
+struct HullInstance
+{
+    const HullSupport* m_Hull;
+    double             m_Rotation[9];
+    Vector             m_Translation;
+
+    HullInstance(const HullSupport* i_Hull);
+
+    // World position of a vertex extreme in the world direction. io_Hint is
+    // passed to HullSupport::support.
+    Point support(const Vector& i_Direction, uint& io_Hint) const;
+    Point vertex(uint i_Index) const;
+};
+
+// State kept between queries on the same pair: the last separating axis and
+// the last extreme vertex of each hull. When the hulls moved little since the
+// previous query, GJK starts next to the answer and the support queries
+// hill-climb only a few steps.
+struct ProximityCache
+{
+    Vector m_Axis;
+    uint   m_HintA;
+    uint   m_HintB;
+    bool   m_IsValid;
+
+    ProximityCache();
+};
+
+struct ProximityResult
+{
+    bool   m_IsOverlapping;
+    double m_Distance;    // Separation distance, or minus the penetration depth
+    Vector m_Axis;        // Unit direction moving B away from A
+    Point  m_PointA;      // Closest (or deepest) points of each hull
+    Point  m_PointB;
+};
+
+// Returns true when the hulls intersect. Stops as soon as a separating axis
+// is found, so this is cheaper than computeProximity on separated pairs.
+bool overlaps(const HullInstance& i_A, const HullInstance& i_B, ProximityCache& io_Cache);
+
+// Distance between separated hulls with GJK, penetration depth of
+// overlapping ones with EPA.
+ProximityResult computeProximity(const HullInstance& i_A, const HullInstance& i_B,
+                                 ProximityCache& io_Cache);
+
+// Answers the queries on pairs of instances in parallel. io_Caches has one
+// entry per pair and is resized if needed.
+void overlaps(const std::vector<HullInstance>& i_Hulls,
+              const std::vector<std::pair<uint, uint>>& i_Pairs,
+              std::vector<ProximityCache>& io_Caches, std::vector<char>& o_Overlaps);
+void computeProximities(const std::vector<HullInstance>& i_Hulls,
+                        const std::vector<std::pair<uint, uint>>& i_Pairs,
+                        std::vector<ProximityCache>& io_Caches,
+                        std::vector<ProximityResult>& o_Results);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,284 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "HullRayCaster.h"
+#include "Parallel.h"
+
+// Barycentric slack, so that lines through an edge shared by two triangles
+// hit at least one of them
+#define RAY_EDGE_TOLERANCE 1e-9
+
+// Rays are traced as a packet if their origins are within this fraction of
+// the hull size from each other
+#define COHERENT_ORIGIN_SPREAD 0.01
+
+// Inverse of a direction component for the slab test. A null component gives
+// the largest double of its sign instead of an infinity, so that an origin on
+// a slab bound gives 0 rather than 0 * inf = NaN.
+static double inverseOf(double i_Component)
+{
+    if (i_Component == 0) {
+        return copysign(std::numeric_limits<double>::max(), i_Component);
+    }
+    return 1 / i_Component;
+}
+
+// Passed by reference to std::min
+const uint HullRayCaster::PACKET_SIZE;
+const uint HullRayCaster::LEAF_SIZE;
+
+HullRayCaster::HullRayCaster(const DCEL3D& i_Hull)
+{
+    // Fan triangulation of each facet, numbered like exportMesh
+    uint facetIdx(0);
+    for (const sptr<Facet>& facet : i_Hull.m_Facets) {
+        if (!facet) {
+            continue;
+        }
+        const Point& corner(*facet->m_AnEdge->m_Origin);
+        sptr<HalfEdge> edge(facet->m_AnEdge->m_Next);
+        while (edge->m_Next != facet->m_AnEdge) {
+            RayTriangle triangle;
+            triangle.m_Corner = corner;
+            triangle.m_Edge1 = *edge->m_Origin - corner;
+            triangle.m_Edge2 = *edge->m_Next->m_Origin - corner;
+            triangle.m_Facet = facetIdx;
+            m_Triangles.push_back(triangle);
+            edge = edge->m_Next;
+        }
+        ++facetIdx;
+    }
+    if (m_Triangles.empty()) {
+        return;
+    }
+
+    // Split the triangles at the median of their centroids along the longest
+    // axis of the node until leaves are small enough
+    std::vector<uint> order(m_Triangles.size());
+    std::vector<Point> centroids(m_Triangles.size());
+    for (uint i = 0; i < m_Triangles.size(); ++i) {
+        const RayTriangle& triangle(m_Triangles[i]);
+        order[i] = i;
+        centroids[i] = triangle.m_Corner + (triangle.m_Edge1 + triangle.m_Edge2) / 3;
+    }
+    m_Nodes.reserve(2 * m_Triangles.size() / LEAF_SIZE + 1);
+    m_Nodes.push_back(BVHNode());
+    buildNode(0, order, centroids, 0, order.size());
+
+    std::vector<RayTriangle> triangles(m_Triangles.size());
+    for (uint i = 0; i < order.size(); ++i) {
+        triangles[i] = m_Triangles[order[i]];
+    }
+    m_Triangles.swap(triangles);
+}
+
+void HullRayCaster::buildNode(uint i_Node, std::vector<uint>& io_Triangles,
+                              const std::vector<Point>& i_Centroids, uint i_Begin, uint i_End)
+{
+    BVHNode node;
+    Point centroidMin(std::numeric_limits<double>::max());
+    Point centroidMax(-std::numeric_limits<double>::max());
+    for (int axis = 0; axis < 3; ++axis) {
+        node.m_Min[axis] = std::numeric_limits<double>::max();
+        node.m_Max[axis] = -std::numeric_limits<double>::max();
+    }
+    for (uint i = i_Begin; i < i_End; ++i) {
+        const RayTriangle& triangle(m_Triangles[io_Triangles[i]]);
+        Point corners[3] = {triangle.m_Corner, triangle.m_Corner + triangle.m_Edge1,
+                            triangle.m_Corner + triangle.m_Edge2};
+        for (int axis = 0; axis < 3; ++axis) {
+            for (const Point& corner : corners) {
+                node.m_Min[axis] = (std::min)(node.m_Min[axis], corner[axis]);
+                node.m_Max[axis] = (std::max)(node.m_Max[axis], corner[axis]);
+            }
+            centroidMin[axis] = (std::min)(centroidMin[axis], i_Centroids[io_Triangles[i]][axis]);
+            centroidMax[axis] = (std::max)(centroidMax[axis], i_Centroids[io_Triangles[i]][axis]);
+        }
+    }
+
+    if (i_End - i_Begin <= LEAF_SIZE) {
+        node.m_First = i_Begin;
+        node.m_Count = i_End - i_Begin;
+        m_Nodes[i_Node] = node;
+        return;
+    }
+
+    int splitAxis(0);
+    for (int axis = 1; axis < 3; ++axis) {
+        if (centroidMax[axis] - centroidMin[axis] > centroidMax[splitAxis] - centroidMin[splitAxis]) {
+            splitAxis = axis;
+        }
+    }
+    uint middle((i_Begin + i_End) / 2);
+    std::nth_element(io_Triangles.begin() + i_Begin, io_Triangles.begin() + middle,
+                     io_Triangles.begin() + i_End, [&](uint i_A, uint i_B) {
+        return i_Centroids[i_A][splitAxis] < i_Centroids[i_B][splitAxis];
+    });
+
+    // Children are consecutive
+    node.m_First = m_Nodes.size();
+    node.m_Count = 0;
+    m_Nodes.push_back(BVHNode());
+    m_Nodes.push_back(BVHNode());
+    m_Nodes[i_Node] = node;
+    buildNode(node.m_First, io_Triangles, i_Centroids, i_Begin, middle);
+    buildNode(node.m_First + 1, io_Triangles, i_Centroids, middle, i_End);
+}
+
+RayHit HullRayCaster::cast(const Ray& i_Ray) const
+{
+    RayHit hit;
+    castPacket(&i_Ray, 1, &hit);
+    return hit;
+}
+
+void HullRayCaster::castPacket(const Ray* i_Rays, uint i_NbRays, RayHit* o_Hits) const
+{
+    // Rays in separate arrays
+    double originX[PACKET_SIZE], originY[PACKET_SIZE], originZ[PACKET_SIZE];
+    double directionX[PACKET_SIZE], directionY[PACKET_SIZE], directionZ[PACKET_SIZE];
+    double inverseX[PACKET_SIZE], inverseY[PACKET_SIZE], inverseZ[PACKET_SIZE];
+    double entryDistances[PACKET_SIZE], exitDistances[PACKET_SIZE];
+    uint entryFacets[PACKET_SIZE], exitFacets[PACKET_SIZE];
+    uint nbLanes((std::min)(i_NbRays, PACKET_SIZE));
+    for (uint i = 0; i < nbLanes; ++i) {
+        const Ray& ray(i_Rays[i]);
+        originX[i] = ray.m_Origin.m_x;
+        originY[i] = ray.m_Origin.m_y;
+        originZ[i] = ray.m_Origin.m_z;
+        directionX[i] = ray.m_Direction.m_x;
+        directionY[i] = ray.m_Direction.m_y;
+        directionZ[i] = ray.m_Direction.m_z;
+        inverseX[i] = inverseOf(ray.m_Direction.m_x);
+        inverseY[i] = inverseOf(ray.m_Direction.m_y);
+        inverseZ[i] = inverseOf(ray.m_Direction.m_z);
+        entryDistances[i] = 0;
+        exitDistances[i] = 0;
+        entryFacets[i] = RAY_MISS;
+        exitFacets[i] = RAY_MISS;
+    }
+
+    // Depth first traversal shared by the packet. A line crosses a convex
+    // hull twice at most, so it stops once every line found both crossings.
+    uint stack[64];
+    uint stackSize(0);
+    if (!m_Nodes.empty()) {
+        stack[stackSize++] = 0;
+    }
+    uint nbDone(0);
+    while (stackSize > 0 && nbDone < nbLanes) {
+        const BVHNode& node(m_Nodes[stack[--stackSize]]);
+
+        // Slab test of the whole line against the box
+        bool isHit(false);
+        for (uint i = 0; i < nbLanes; ++i) {
+            double x1((node.m_Min[0] - originX[i]) * inverseX[i]);
+            double x2((node.m_Max[0] - originX[i]) * inverseX[i]);
+            double y1((node.m_Min[1] - originY[i]) * inverseY[i]);
+            double y2((node.m_Max[1] - originY[i]) * inverseY[i]);
+            double z1((node.m_Min[2] - originZ[i]) * inverseZ[i]);
+            double z2((node.m_Max[2] - originZ[i]) * inverseZ[i]);
+            double near((std::max)((std::max)((std::min)(x1, x2), (std::min)(y1, y2)), (std::min)(z1, z2)));
+            double far((std::min)((std::min)((std::max)(x1, x2), (std::max)(y1, y2)), (std::max)(z1, z2)));
+            isHit |= near <= far;
+        }
+        if (!isHit) {
+            continue;
+        }
+
+        if (node.m_Count == 0) {
+            stack[stackSize++] = node.m_First + 1;
+            stack[stackSize++] = node.m_First;
+            continue;
+        }
+
+        // Moller-Trumbore. The determinant is positive when the line enters
+        // through the triangle (outward normal against the direction).
+        for (uint t = node.m_First; t < node.m_First + node.m_Count; ++t) {
+            const RayTriangle& triangle(m_Triangles[t]);
+            const Vector& e1(triangle.m_Edge1);
+            const Vector& e2(triangle.m_Edge2);
+            for (uint i = 0; i < nbLanes; ++i) {
+                double px(directionY[i] * e2.m_z - directionZ[i] * e2.m_y);
+                double py(directionZ[i] * e2.m_x - directionX[i] * e2.m_z);
+                double pz(directionX[i] * e2.m_y - directionY[i] * e2.m_x);
+                double determinant(e1.m_x * px + e1.m_y * py + e1.m_z * pz);
+                double inverse(1 / determinant);
+                double sx(originX[i] - triangle.m_Corner.m_x);
+                double sy(originY[i] - triangle.m_Corner.m_y);
+                double sz(originZ[i] - triangle.m_Corner.m_z);
+                double u((sx * px + sy * py + sz * pz) * inverse);
+                double qx(sy * e1.m_z - sz * e1.m_y);
+                double qy(sz * e1.m_x - sx * e1.m_z);
+                double qz(sx * e1.m_y - sy * e1.m_x);
+                double v((directionX[i] * qx + directionY[i] * qy + directionZ[i] * qz) * inverse);
+                double distance((e2.m_x * qx + e2.m_y * qy + e2.m_z * qz) * inverse);
+                bool isInside(determinant != 0 && u >= -RAY_EDGE_TOLERANCE && v >= -RAY_EDGE_TOLERANCE &&
+                              u + v <= 1 + RAY_EDGE_TOLERANCE);
+                bool isEntry(isInside && determinant > 0);
+                bool isExit(isInside && determinant < 0);
+                entryDistances[i] = isEntry ? distance : entryDistances[i];
+                entryFacets[i] = isEntry ? triangle.m_Facet : entryFacets[i];
+                exitDistances[i] = isExit ? distance : exitDistances[i];
+                exitFacets[i] = isExit ? triangle.m_Facet : exitFacets[i];
+            }
+        }
+        nbDone = 0;
+        for (uint i = 0; i < nbLanes; ++i) {
+            nbDone += entryFacets[i] != RAY_MISS && exitFacets[i] != RAY_MISS ? 1 : 0;
+        }
+    }
+
+    // A line grazing the hull can be seen crossing only one side
+    for (uint i = 0; i < nbLanes; ++i) {
+        bool isMiss(entryFacets[i] == RAY_MISS || exitFacets[i] == RAY_MISS);
+        o_Hits[i].m_EntryFacet = isMiss ? RAY_MISS : entryFacets[i];
+        o_Hits[i].m_ExitFacet = isMiss ? RAY_MISS : exitFacets[i];
+        o_Hits[i].m_EntryDistance = entryDistances[i];
+        o_Hits[i].m_ExitDistance = exitDistances[i];
+    }
+}
+
+bool HullRayCaster::isCoherent(const Ray* i_Rays, uint i_NbRays) const
+{
+    if (m_Nodes.empty()) {
+        return true;
+    }
+    const BVHNode& root(m_Nodes[0]);
+    double size(0);
+    for (int axis = 0; axis < 3; ++axis) {
+        size = (std::max)(size, root.m_Max[axis] - root.m_Min[axis]);
+    }
+
+    // Same direction octant, and origins close to each other
+    for (uint i = 1; i < i_NbRays; ++i) {
+        for (int axis = 0; axis < 3; ++axis) {
+            if ((i_Rays[i].m_Direction[axis] < 0) != (i_Rays[0].m_Direction[axis] < 0) ||
+                fabs(i_Rays[i].m_Origin[axis] - i_Rays[0].m_Origin[axis]) > COHERENT_ORIGIN_SPREAD * size) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void HullRayCaster::cast(const Ray* i_Rays, uint i_NbRays, RayHit* o_Hits) const
+{
+    uint nbPackets((i_NbRays + PACKET_SIZE - 1) / PACKET_SIZE);
+    parallelFor(0, nbPackets, [&](uint, uint i_Begin, uint i_End) {
+        for (uint packet = i_Begin; packet < i_End; ++packet) {
+            uint first(packet * PACKET_SIZE);
+            uint nbRays((std::min)(PACKET_SIZE, i_NbRays - first));
+            if (isCoherent(i_Rays + first, nbRays)) {
+                castPacket(i_Rays + first, nbRays, o_Hits + first);
+                continue;
+            }
+
+            // Packets of unrelated rays visit the union of their paths
+            for (uint i = first; i < first + nbRays; ++i) {
+                castPacket(i_Rays + i, 1, o_Hits + i);
+            }
+        }
+    });
+}
\ No newline at end of file
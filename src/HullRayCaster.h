@@ -0,0 +1,80 @@
+#ifndef __HullRayCaster__
+#define __HullRayCaster__
+
+#include <vector>
+
+#include "DCEL3D.h"
+
+// Facet of a ray that misses the hull
+#define RAY_MISS uint(-1)
+
+struct Ray
+{
+    Point  m_Origin;
+    Vector m_Direction;
+};
+
+// Where the line of a ray crosses the hull. Distances are in units of the ray
+// direction and can be negative: the entry is behind the origin when the
+// origin is inside.
+struct RayHit
+{
+    uint   m_EntryFacet;        // RAY_MISS when the line misses the hull
+    uint   m_ExitFacet;
+    double m_EntryDistance;
+    double m_ExitDistance;
+};
+
+// Node of the hierarchy. Inner nodes have their children at m_First and
+// m_First + 1, leaves own m_Count triangles from m_First.
+struct BVHNode
+{
+    double m_Min[3];
+    double m_Max[3];
+    uint   m_First;
+    uint   m_Count;
+};
+
+// Triangle of the fan triangulation of a facet, ready for the Moller-Trumbore
+// test
+struct RayTriangle
+{
+    Point  m_Corner;
+    Vector m_Edge1;
+    Vector m_Edge2;
+    uint   m_Facet;
+};
+
+// Ray casting against a built hull through a bounding volume hierarchy of
+// its facet triangles. Facets are numbered in the order of exportMesh. Rays
+// are traced in packets of PACKET_SIZE that share the traversal, the loops
+// over the rays of a packet being vectorizable.
+struct HullRayCaster
+{
+    static const uint PACKET_SIZE = 8;
+    static const uint LEAF_SIZE = 4;
+
+    std::vector<BVHNode>     m_Nodes;       // Root first
+    std::vector<RayTriangle> m_Triangles;   // In leaf order
+
+    HullRayCaster(const DCEL3D& i_Hull);
+
+    RayHit cast(const Ray& i_Ray) const;
+
+    // Up to PACKET_SIZE rays, traced together
+    void castPacket(const Ray* i_Rays, uint i_NbRays, RayHit* o_Hits) const;
+
+    // Any number of rays, packets being traced in parallel. Consecutive rays
+    // that are coherent (close origins, same direction octant) share a
+    // packet, other ones are traced one by one.
+    void cast(const Ray* i_Rays, uint i_NbRays, RayHit* o_Hits) const;
+
+    bool isCoherent(const Ray* i_Rays, uint i_NbRays) const;
+
+    // Fills node i_Node (already allocated) with triangles [i_Begin, i_End)
+    // of io_Triangles, which it reorders
+    void buildNode(uint i_Node, std::vector<uint>& io_Triangles, const std::vector<Point>& i_Centroids,
+                   uint i_Begin, uint i_End);
+};
+
+#endif
\ No newline at end of file
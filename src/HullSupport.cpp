@@ -0,0 +1,251 @@
+#include <unordered_map>
+
+#include "HullSupport.h"
+#include "Parallel.h"
+#include "TriangleMeshHull.h"
+
+#define NOT_KEPT uint(-1)
+
+// Neighbors of each vertex, from directed edges (both directions are given)
+static void buildAdjacency(uint i_NbVertices, const std::vector<std::pair<uint, uint>>& i_Edges,
+                           std::vector<uint>& o_Starts, std::vector<uint>& o_Neighbors)
+{
+    o_Starts.assign(i_NbVertices + 1, 0);
+    for (const std::pair<uint, uint>& edge : i_Edges) {
+        ++o_Starts[edge.first + 1];
+    }
+    for (uint i = 0; i < i_NbVertices; ++i) {
+        o_Starts[i + 1] += o_Starts[i];
+    }
+
+    o_Neighbors.resize(i_Edges.size());
+    std::vector<uint> ends(o_Starts.begin(), o_Starts.end() - 1);
+    for (const std::pair<uint, uint>& edge : i_Edges) {
+        o_Neighbors[ends[edge.first]++] = edge.second;
+    }
+}
+
+HullSupport::HullSupport(const DCEL3D& i_Hull)
+{
+    // Number hull vertices and collect edges
+    std::unordered_map<const Point*, uint> indexOfPt;
+    std::vector<std::pair<uint, uint>> edges;
+    auto indexOf = [&](const sPoint& i_Pt) {
+        auto inserted(indexOfPt.emplace(i_Pt.get(), m_Points.size()));
+        if (inserted.second) {
+            m_Points.push_back(*i_Pt);
+        }
+        return inserted.first->second;
+    };
+
+    for (const sptr<Facet>& facet : i_Hull.m_Facets) {
+        if (!facet) {
+            continue;
+        }
+        sptr<HalfEdge> edge(facet->m_AnEdge);
+        do {
+            edges.emplace_back(indexOf(edge->m_Origin), indexOf(edge->m_Next->m_Origin));
+            edge = edge->m_Next;
+        } while (edge != facet->m_AnEdge);
+    }
+
+    buildAdjacency(m_Points.size(), edges, m_NeighborStarts, m_Neighbors);
+
+    if (m_Points.size() > HILL_CLIMBING_MAX_VERTICES) {
+        buildHierarchy(edges);
+    }
+}
+
+HullSupport::HullSupport(const TriangleMesh& i_Mesh, const Point* i_Pts, std::vector<uint>& o_Vertices)
+{
+    // Number mesh vertices in order of appearance
+    uint nbPts(0);
+    for (uint vertex : i_Mesh.m_Origins) {
+        nbPts = (std::max)(nbPts, vertex + 1);
+    }
+    std::vector<uint> indexOfPt(nbPts, NOT_KEPT);
+    auto indexOf = [&](uint i_Vertex) {
+        if (indexOfPt[i_Vertex] == NOT_KEPT) {
+            indexOfPt[i_Vertex] = m_Points.size();
+            m_Points.push_back(i_Pts[i_Vertex]);
+            o_Vertices.push_back(i_Vertex);
+        }
+        return indexOfPt[i_Vertex];
+    };
+
+    std::vector<std::pair<uint, uint>> edges;
+    edges.reserve(i_Mesh.m_Origins.size());
+    for (uint halfEdge = 0; halfEdge < i_Mesh.m_Origins.size(); ++halfEdge) {
+        edges.emplace_back(indexOf(i_Mesh.m_Origins[halfEdge]), indexOf(i_Mesh.target(halfEdge)));
+    }
+
+    buildAdjacency(m_Points.size(), edges, m_NeighborStarts, m_Neighbors);
+
+    if (m_Points.size() > HILL_CLIMBING_MAX_VERTICES) {
+        buildHierarchy(edges);
+    }
+}
+
+void HullSupport::buildHierarchy(const std::vector<std::pair<uint, uint>>& i_Edges)
+{
+    // Finest level is the hull itself
+    SupportLevel level;
+    for (uint i = 0; i < m_Points.size(); ++i) {
+        level.m_Vertices.push_back(i);
+    }
+    std::vector<std::pair<uint, uint>> edges(i_Edges);
+    std::vector<uint> starts, neighbors;
+
+    while (level.m_Vertices.size() > TOP_LEVEL_MAX_VERTICES) {
+        uint nbVertices(level.m_Vertices.size());
+        buildAdjacency(nbVertices, edges, starts, neighbors);
+
+        // Greedy independent set of vertices of degree at most 8
+        std::vector<char> isRemoved(nbVertices, 0);
+        std::vector<char> isBlocked(nbVertices, 0);
+        for (uint i = 0; i < nbVertices; ++i) {
+            if (isBlocked[i] || starts[i + 1] - starts[i] > 8) {
+                continue;
+            }
+            isRemoved[i] = 1;
+            for (uint n = starts[i]; n < starts[i + 1]; ++n) {
+                isBlocked[neighbors[n]] = 1;
+            }
+        }
+
+        // Hull of the other vertices
+        std::vector<uint> kept;
+        std::vector<Point> keptPts;
+        for (uint i = 0; i < nbVertices; ++i) {
+            if (!isRemoved[i]) {
+                kept.push_back(i);
+                keptPts.push_back(m_Points[level.m_Vertices[i]]);
+            }
+        }
+        if (kept.size() == nbVertices || kept.size() < 4) {
+            break;
+        }
+        TriangleMeshHull hull(keptPts.data(), keptPts.size());
+        if (!hull.compute()) {
+            break;
+        }
+
+        // Vertices of the next level (points of the hull that are coplanar
+        // with a facet may be dropped, they are never strictly extreme) with
+        // their removed neighbors
+        SupportLevel next;
+        std::vector<uint> indexInNext(kept.size(), NOT_KEPT);
+        for (uint vertex : hull.m_Mesh.m_Origins) {
+            if (indexInNext[vertex] != NOT_KEPT) {
+                continue;
+            }
+            indexInNext[vertex] = next.m_Vertices.size();
+            next.m_Vertices.push_back(level.m_Vertices[kept[vertex]]);
+
+            LevelVertex link;
+            link.m_Parent = kept[vertex];
+            link.m_RemovedBegin = level.m_Removed.size();
+            for (uint n = starts[link.m_Parent]; n < starts[link.m_Parent + 1]; ++n) {
+                if (isRemoved[neighbors[n]]) {
+                    RemovedVertex removed;
+                    removed.m_Pt = m_Points[level.m_Vertices[neighbors[n]]];
+                    removed.m_Index = neighbors[n];
+                    level.m_Removed.push_back(removed);
+                }
+            }
+            link.m_RemovedEnd = level.m_Removed.size();
+            next.m_Links.push_back(link);
+        }
+
+        // Edges of the next level
+        edges.clear();
+        for (uint halfEdge = 0; halfEdge < hull.m_Mesh.m_Origins.size(); ++halfEdge) {
+            edges.emplace_back(indexInNext[hull.m_Mesh.m_Origins[halfEdge]],
+                               indexInNext[hull.m_Mesh.target(halfEdge)]);
+        }
+
+        m_Levels.push_back(std::move(level));
+        level = std::move(next);
+    }
+
+    m_Levels.push_back(std::move(level));
+}
+
+uint HullSupport::hillClimb(const Vector& i_Direction, uint i_Start) const
+{
+    // Move to the best neighbor until none is better (a local maximum is
+    // global on a convex polytope)
+    uint current(i_Start);
+    double currentValue(dot(i_Direction, m_Points[current]));
+    while (true) {
+        uint best(current);
+        for (uint n = m_NeighborStarts[current]; n < m_NeighborStarts[current + 1]; ++n) {
+            double value(dot(i_Direction, m_Points[m_Neighbors[n]]));
+            if (value > currentValue) {
+                currentValue = value;
+                best = m_Neighbors[n];
+            }
+        }
+        if (best == current) {
+            return current;
+        }
+        current = best;
+    }
+}
+
+uint HullSupport::descendHierarchy(const Vector& i_Direction) const
+{
+    // Exhaustive search on the coarsest level
+    const SupportLevel& top(m_Levels.back());
+    uint best(0);
+    double bestValue(dot(i_Direction, m_Points[top.m_Vertices[0]]));
+    for (uint i = 1; i < top.m_Vertices.size(); ++i) {
+        double value(dot(i_Direction, m_Points[top.m_Vertices[i]]));
+        if (value > bestValue) {
+            bestValue = value;
+            best = i;
+        }
+    }
+
+    // Then only the removed neighbors of the current answer can do better
+    for (uint levelIdx = m_Levels.size() - 1; levelIdx > 0; --levelIdx) {
+        const LevelVertex& link(m_Levels[levelIdx].m_Links[best]);
+        const std::vector<RemovedVertex>& removed(m_Levels[levelIdx - 1].m_Removed);
+        best = link.m_Parent;
+        for (uint n = link.m_RemovedBegin; n < link.m_RemovedEnd; ++n) {
+            double value(dot(i_Direction, removed[n].m_Pt));
+            if (value > bestValue) {
+                bestValue = value;
+                best = removed[n].m_Index;
+            }
+        }
+    }
+
+    return m_Levels[0].m_Vertices[best];
+}
+
+uint HullSupport::support(const Vector& i_Direction, uint& io_Hint) const
+{
+    if (m_Levels.empty()) {
+        io_Hint = hillClimb(i_Direction, io_Hint < m_Points.size() ? io_Hint : 0);
+    } else {
+        io_Hint = descendHierarchy(i_Direction);
+    }
+    return io_Hint;
+}
+
+uint HullSupport::support(const Vector& i_Direction) const
+{
+    uint hint(0);
+    return support(i_Direction, hint);
+}
+
+void HullSupport::support(const Vector* i_Directions, uint i_NbDirections, uint* o_Vertices) const
+{
+    parallelFor(0, i_NbDirections, [&](uint, uint i_Begin, uint i_End) {
+        uint hint(0);
+        for (uint i = i_Begin; i < i_End; ++i) {
+            o_Vertices[i] = support(i_Directions[i], hint);
+        }
+    });
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#ifndef __HullSupport__
+#define __HullSupport__
+
+#include <vector>
+
+#include "DCEL3D.h"
+#include "TriangleMesh.h"
+
+// Vertex removed from a level of the hierarchy, with its index in the level
+struct RemovedVertex
+{
+    Point m_Pt;
+    uint  m_Index;
+};
+
+// Vertex of a level of the hierarchy: its index in the previous level, and
+// the range of its neighbors in the previous level that were removed
+struct LevelVertex
+{
+    uint m_Parent;
+    uint m_RemovedBegin;
+    uint m_RemovedEnd;
+};
+
+// One level of the Dobkin-Kirkpatrick hierarchy. Level i + 1 is the hull of
+// level i without an independent set of low degree vertices, so the extreme
+// vertex of level i is either the one of level i + 1 or one of its neighbors
+// removed from level i. Everything a query reads at a level is stored
+// together.
+struct SupportLevel
+{
+    std::vector<uint>          m_Vertices;    // Index in HullSupport::m_Points
+    std::vector<LevelVertex>   m_Links;       // Empty for the finest level
+    std::vector<RemovedVertex> m_Removed;     // Vertices removed from this level
+};
+
+// Support (extreme vertex) queries on a built hull. Small hulls hill-climb
+// over the vertex adjacency from the previous answer, larger ones descend a
+// Dobkin-Kirkpatrick hierarchy in O(log n).
+struct HullSupport
+{
+    // Hulls up to this many vertices only use hill climbing
+    static const uint HILL_CLIMBING_MAX_VERTICES = 128;
+
+    // The coarsest level is searched exhaustively
+    static const uint TOP_LEVEL_MAX_VERTICES = 16;
+
+    std::vector<Point>        m_Points;
+    std::vector<uint>         m_NeighborStarts;
+    std::vector<uint>         m_Neighbors;
+    std::vector<SupportLevel> m_Levels;    // Finest first, empty for small hulls
+
+    HullSupport(const DCEL3D& i_Hull);
+
+    // From the compact facet array of the triangle mesh engine, whose
+    // vertices are indices in i_Pts. o_Vertices receives the index in i_Pts
+    // of each vertex of m_Points.
+    HullSupport(const TriangleMesh& i_Mesh, const Point* i_Pts, std::vector<uint>& o_Vertices);
+
+    // Index in m_Points of a vertex extreme in the direction. io_Hint is the
+    // previous answer (any vertex index works) and receives the new one.
+    uint support(const Vector& i_Direction, uint& io_Hint) const;
+    uint support(const Vector& i_Direction) const;
+
+    // Answers queries in parallel. Consecutive directions are expected to be
+    // close, each answer being the hint of the next query of its thread.
+    void support(const Vector* i_Directions, uint i_NbDirections, uint* o_Vertices) const;
+
+    uint hillClimb(const Vector& i_Direction, uint i_Start) const;
+    uint descendHierarchy(const Vector& i_Direction) const;
+    void buildHierarchy(const std::vector<std::pair<uint, uint>>& i_Edges);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <unordered_set>
+
+#include "Deduplication.h"
+#include "Degeneracy.h"
+#include "InputStatistics.h"
+#include "TriangleMeshHull.h"
+
+InputStatistics::InputStatistics() :
+    m_NbPts(0),
+    m_SampleSize(0),
+    m_SampleHullSize(0),
+    m_HullRatio(0),
+    m_HullGrowth(0),
+    m_EstimatedHullSize(0),
+    m_Dimension(0),
+    m_Thickness(0),
+    m_DuplicateRate(0)
+{}
+
+// Number of distinct vertices of the hull of the points, 0 if they are flat
+static uint countHullVertices(const std::vector<Point>& i_Pts)
+{
+    TriangleMeshHull hull(i_Pts.data(), i_Pts.size());
+    if (!hull.compute()) {
+        return 0;
+    }
+    std::vector<uint> vertices(hull.m_Mesh.m_Origins);
+    std::sort(vertices.begin(), vertices.end());
+    return std::unique(vertices.begin(), vertices.end()) - vertices.begin();
+}
+
+InputStatistics sampleInput(const std::vector<sPoint>& i_Pts, uint i_SampleSize, double i_SnapTolerance)
+{
+    InputStatistics statistics;
+    statistics.m_NbPts = i_Pts.size();
+    if (i_Pts.empty()) {
+        return statistics;
+    }
+
+    // Distinct random indices, in random order so that any prefix is a
+    // random sample too
+    std::mt19937 rng(0);
+    std::vector<uint> sample;
+    if (i_SampleSize >= i_Pts.size()) {
+        for (uint i = 0; i < i_Pts.size(); ++i) {
+            sample.push_back(i);
+        }
+        std::shuffle(sample.begin(), sample.end(), rng);
+    } else {
+        std::uniform_int_distribution<uint> uni(0, i_Pts.size() - 1);
+        std::unordered_set<uint> isSampled;
+        while (sample.size() < i_SampleSize) {
+            uint index(uni(rng));
+            if (isSampled.insert(index).second) {
+                sample.push_back(index);
+            }
+        }
+    }
+    statistics.m_SampleSize = sample.size();
+
+    std::vector<sPoint> samplePts;
+    std::vector<Point> pts;
+    for (uint index : sample) {
+        samplePts.push_back(i_Pts[index]);
+        pts.push_back(*i_Pts[index]);
+    }
+
+    // Flatness, relative to the diagonal of the sample
+    FlatnessInfo info(analyzeFlatness(samplePts, 0));
+    Point min(pts[0]), max(pts[0]);
+    for (const Point& pt : pts) {
+        for (int axis = 0; axis < 3; ++axis) {
+            min[axis] = (std::min)(min[axis], pt[axis]);
+            max[axis] = (std::max)(max[axis], pt[axis]);
+        }
+    }
+    double diagonal((max - min).norm());
+    statistics.m_Dimension = info.m_Dimension;
+    statistics.m_Thickness = diagonal > 0 ? info.m_MaxPlaneDist / diagonal : 0;
+
+    // Hull sizes of the sample and of its first quarter
+    statistics.m_SampleHullSize = countHullVertices(pts);
+    statistics.m_HullRatio = double(statistics.m_SampleHullSize) / pts.size();
+    pts.resize(pts.size() / 4);
+    uint quarterHullSize(countHullVertices(pts));
+    if (statistics.m_SampleHullSize > 0 && quarterHullSize > 0) {
+        double growth(log(double(statistics.m_SampleHullSize) / quarterHullSize) / log(4.0));
+        statistics.m_HullGrowth = (std::max)(0.0, (std::min)(1.0, growth));
+    } else {
+        statistics.m_HullGrowth = 1;
+    }
+    double scale(double(statistics.m_NbPts) / statistics.m_SampleSize);
+    statistics.m_EstimatedHullSize = (std::min)(double(statistics.m_NbPts),
+                                                statistics.m_SampleHullSize * pow(scale, statistics.m_HullGrowth));
+
+    statistics.m_DuplicateRate = estimateDuplicateRate(i_Pts, sample, i_SnapTolerance);
+    return statistics;
+}
\ No newline at end of file
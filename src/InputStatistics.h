@@ -0,0 +1,32 @@
+#ifndef __InputStatistics__
+#define __InputStatistics__
+
+#include <vector>
+
+#include "DCEL3D.h"
+
+// What a small random sample of the input tells about it, to pick the engine
+// and prefilters
+struct InputStatistics
+{
+    uint   m_NbPts;
+    uint   m_SampleSize;
+    uint   m_SampleHullSize;       // Vertices of the hull of the sample
+    double m_HullRatio;            // m_SampleHullSize / m_SampleSize
+    double m_HullGrowth;           // Exponent of the growth of the hull size
+    double m_EstimatedHullSize;    // For the whole input
+    uint   m_Dimension;            // Of the sample (see FlatnessInfo)
+    double m_Thickness;            // Distance from the fitted plane, relative to the diagonal
+    double m_DuplicateRate;        // Estimated fraction of points merged with another point
+
+    InputStatistics();
+};
+
+// Samples i_SampleSize points (a fixed seed, so the result is reproducible).
+// The hull size growth is measured between the hulls of a quarter of the
+// sample and of the whole sample, and extrapolated to the input size. The
+// duplicate rate is the fraction of sampled points sharing their cell with
+// another input point (see estimateDuplicateRate).
+InputStatistics sampleInput(const std::vector<sPoint>& i_Pts, uint i_SampleSize, double i_SnapTolerance);
+
+#endif
\ No newline at end of file
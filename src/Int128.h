@@ -0,0 +1,82 @@
+#ifndef __Int128__
+#define __Int128__
+
+// Signed 128-bit integer, only with what exact predicates need: products of
+// two 64-bit integers, sums and comparisons.
+#if defined(__SIZEOF_INT128__)
+
+typedef __int128 Int128;
+
+inline Int128 mul128(long long i_A, long long i_B)
+{
+    return Int128(i_A) * i_B;
+}
+
+#else
+
+struct Int128
+{
+    unsigned long long m_Lo;
+    long long          m_Hi;
+
+    Int128() : m_Lo(0), m_Hi(0) {}
+    Int128(long long i_Value) : m_Lo((unsigned long long)i_Value), m_Hi(i_Value < 0 ? -1 : 0) {}
+    Int128(long long i_Hi, unsigned long long i_Lo) : m_Lo(i_Lo), m_Hi(i_Hi) {}
+
+    Int128 operator+(const Int128& i_Other) const
+    {
+        unsigned long long lo(m_Lo + i_Other.m_Lo);
+        return Int128(m_Hi + i_Other.m_Hi + (lo < m_Lo ? 1 : 0), lo);
+    }
+
+    Int128 operator-() const
+    {
+        unsigned long long lo(~m_Lo + 1);
+        return Int128(~m_Hi + (lo == 0 ? 1 : 0), lo);
+    }
+
+    bool operator==(const Int128& i_Other) const
+    {
+        return m_Hi == i_Other.m_Hi && m_Lo == i_Other.m_Lo;
+    }
+
+    bool operator!=(const Int128& i_Other) const
+    {
+        return !(*this == i_Other);
+    }
+
+    bool operator>(const Int128& i_Other) const
+    {
+        return m_Hi > i_Other.m_Hi || (m_Hi == i_Other.m_Hi && m_Lo > i_Other.m_Lo);
+    }
+
+    bool operator<(const Int128& i_Other) const
+    {
+        return i_Other > *this;
+    }
+};
+
+inline Int128 mul128(long long i_A, long long i_B)
+{
+    // Multiply magnitudes with 32-bit halves, then fix the sign
+    unsigned long long a(i_A < 0 ? 0 - (unsigned long long)i_A : i_A);
+    unsigned long long b(i_B < 0 ? 0 - (unsigned long long)i_B : i_B);
+    unsigned long long aLo(a & 0xffffffff), aHi(a >> 32);
+    unsigned long long bLo(b & 0xffffffff), bHi(b >> 32);
+
+    unsigned long long lolo(aLo * bLo);
+    unsigned long long hilo(aHi * bLo);
+    unsigned long long lohi(aLo * bHi);
+    unsigned long long hihi(aHi * bHi);
+
+    unsigned long long middle((lolo >> 32) + (hilo & 0xffffffff) + (lohi & 0xffffffff));
+    unsigned long long lo((middle << 32) | (lolo & 0xffffffff));
+    unsigned long long hi(hihi + (hilo >> 32) + (lohi >> 32) + (middle >> 32));
+
+    Int128 product((long long)hi, lo);
+    return (i_A < 0) != (i_B < 0) ? -product : product;
+}
+
+#endif
+
+#endif
\ No newline at end of file
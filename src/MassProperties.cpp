@@ -0,0 +1,174 @@
+#include <cmath>
+
+#include "MassProperties.h"
+#include "Parallel.h"
+
+// Volume, area, first moment (3) and second moment (6) sums
+#define NB_MOMENTS 11
+
+MassProperties::MassProperties() :
+    m_Volume(0),
+    m_Area(0),
+    m_Centroid(0, 0, 0),
+    m_Inertia{0, 0, 0, 0, 0, 0, 0, 0, 0}
+{}
+
+/************************************************************************/
+/*                               Moments                                */
+/************************************************************************/
+
+// Neumaier's variant of Kahan summation, which also holds when the added
+// value is larger than the sum
+struct CompensatedSum
+{
+    double m_Sum;
+    double m_Error;
+
+    CompensatedSum() : m_Sum(0), m_Error(0) {}
+
+    void add(double i_Value)
+    {
+        double sum(m_Sum + i_Value);
+        m_Error += fabs(m_Sum) >= fabs(i_Value) ? (m_Sum - sum) + i_Value : (i_Value - sum) + m_Sum;
+        m_Sum = sum;
+    }
+
+    double value() const { return m_Sum + m_Error; }
+};
+
+struct Moments
+{
+    CompensatedSum m_Sums[NB_MOMENTS];
+
+    // Triangle abc, relative to the reference vertex
+    void addTriangle(const Vector& i_A, const Vector& i_B, const Vector& i_C)
+    {
+        Vector normal(cross(i_B - i_A, i_C - i_A));
+        double det(dot(i_A, cross(i_B, i_C)));
+        Vector sum(i_A + i_B + i_C);
+
+        m_Sums[0].add(det / 6);
+        m_Sums[1].add(normal.norm() / 2);
+        for (int axis = 0; axis < 3; ++axis) {
+            m_Sums[2 + axis].add(det / 24 * sum[axis]);
+        }
+
+        // Integral of x_j x_k over the tetrahedron with the reference vertex
+        int moment(5);
+        for (int j = 0; j < 3; ++j) {
+            for (int k = j; k < 3; ++k) {
+                double products(i_A[j] * i_A[k] + i_B[j] * i_B[k] + i_C[j] * i_C[k] + sum[j] * sum[k]);
+                m_Sums[moment++].add(det / 120 * products);
+            }
+        }
+    }
+};
+
+// Adds the per-thread sums in order and turns them into mass properties
+static MassProperties finalize(const std::vector<Moments>& i_Moments, const Point& i_Reference)
+{
+    double totals[NB_MOMENTS];
+    for (uint i = 0; i < NB_MOMENTS; ++i) {
+        CompensatedSum total;
+        for (const Moments& moments : i_Moments) {
+            total.add(moments.m_Sums[i].value());
+        }
+        totals[i] = total.value();
+    }
+
+    MassProperties properties;
+    properties.m_Volume = totals[0];
+    properties.m_Area = totals[1];
+    if (properties.m_Volume <= 0) {
+        properties.m_Centroid = i_Reference;
+        return properties;
+    }
+
+    // Centroid, then second moments about it
+    Vector centroid(totals[2], totals[3], totals[4]);
+    centroid /= properties.m_Volume;
+    properties.m_Centroid = i_Reference + centroid;
+
+    double covariance[3][3];
+    int moment(5);
+    for (int j = 0; j < 3; ++j) {
+        for (int k = j; k < 3; ++k) {
+            covariance[j][k] = totals[moment++] - properties.m_Volume * centroid[j] * centroid[k];
+            covariance[k][j] = covariance[j][k];
+        }
+    }
+    double trace(covariance[0][0] + covariance[1][1] + covariance[2][2]);
+    for (int j = 0; j < 3; ++j) {
+        for (int k = 0; k < 3; ++k) {
+            properties.m_Inertia[3 * j + k] = (j == k ? trace : 0) - covariance[j][k];
+        }
+    }
+    return properties;
+}
+
+/************************************************************************/
+/*                        computeMassProperties                         */
+/************************************************************************/
+
+template <typename Scalar>
+MassProperties computeMassProperties(const TriangleMesh& i_Mesh, const TPoint<Scalar>* i_Pts,
+                                     double i_Scale)
+{
+    if (i_Mesh.nbFacets() == 0) {
+        return MassProperties();
+    }
+
+    // Coordinates relative to a hull vertex keep the products small
+    Point reference(Point(i_Pts[i_Mesh.m_Origins[0]]) * i_Scale);
+    auto relative = [&](uint i_Vertex) {
+        return Point(i_Pts[i_Vertex]) * i_Scale - reference;
+    };
+
+    std::vector<Moments> moments(nbThreads());
+    parallelFor(0, i_Mesh.nbFacets(), [&](uint i_ThreadID, uint i_Begin, uint i_End) {
+        Moments threadMoments;
+        for (uint facet = i_Begin; facet < i_End; ++facet) {
+            const uint* origins(&i_Mesh.m_Origins[3 * facet]);
+            threadMoments.addTriangle(relative(origins[0]), relative(origins[1]), relative(origins[2]));
+        }
+        moments[i_ThreadID] = threadMoments;
+    });
+
+    return finalize(moments, reference);
+}
+
+template MassProperties computeMassProperties(const TriangleMesh&, const TPoint<int>*, double);
+template MassProperties computeMassProperties(const TriangleMesh&, const TPoint<float>*, double);
+template MassProperties computeMassProperties(const TriangleMesh&, const TPoint<double>*, double);
+
+MassProperties computeMassProperties(const DCEL3D& i_Hull)
+{
+    const Facet* firstFacet(NULL);
+    for (uint i = 0; i < i_Hull.m_Facets.size() && !firstFacet; ++i) {
+        firstFacet = i_Hull.m_Facets[i].get();
+    }
+    if (!firstFacet) {
+        return MassProperties();
+    }
+    Point reference(*firstFacet->m_AnEdge->m_Origin);
+
+    // Raw pointers, so that threads do not contend on reference counts
+    std::vector<Moments> moments(nbThreads());
+    parallelFor(0, i_Hull.m_Facets.size(), [&](uint i_ThreadID, uint i_Begin, uint i_End) {
+        Moments threadMoments;
+        for (uint i = i_Begin; i < i_End; ++i) {
+            const Facet* facet(i_Hull.m_Facets[i].get());
+            if (!facet) {
+                continue;
+            }
+            const HalfEdge* first(facet->m_AnEdge.get());
+            Vector corner(*first->m_Origin - reference);
+            for (const HalfEdge* edge = first->m_Next.get(); edge->m_Next.get() != first; edge = edge->m_Next.get()) {
+                threadMoments.addTriangle(corner, *edge->m_Origin - reference, *edge->m_Next->m_Origin - reference);
+            }
+        }
+        moments[i_ThreadID] = threadMoments;
+    });
+
+    return finalize(moments, reference);
+}
\ No newline at end of file
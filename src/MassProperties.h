@@ -0,0 +1,33 @@
+#ifndef __MassProperties__
+#define __MassProperties__
+
+#include "DCEL3D.h"
+#include "TriangleMesh.h"
+
+// Volume, surface area, centroid and inertia tensor of a hull, seen as a
+// solid of unit density. Each facet triangle adds the moments of the
+// tetrahedron it forms with a hull vertex. Triangles are summed in parallel
+// with compensated (Kahan-Babuska) sums, one per thread, that are then added
+// in thread order, so the result does not depend on the number of threads
+// beyond rounding.
+struct MassProperties
+{
+    double m_Volume;
+    double m_Area;
+    Point  m_Centroid;
+    double m_Inertia[9];     // Row-major, about the centroid
+
+    MassProperties();
+};
+
+// From the compact facet array of the triangle mesh engine. Vertices are
+// indices in i_Pts, whose coordinates are multiplied by i_Scale (the grid
+// step of snapped points).
+template <typename Scalar>
+MassProperties computeMassProperties(const TriangleMesh& i_Mesh, const TPoint<Scalar>* i_Pts,
+                                     double i_Scale = 1);
+
+// From the facets of a DCEL, fan triangulated
+MassProperties computeMassProperties(const DCEL3D& i_Hull);
+
+#endif
\ No newline at end of file
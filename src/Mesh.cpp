@@ -0,0 +1,83 @@
+#include <unordered_map>
+
+#include "Mesh.h"
+
+Mesh exportMesh(const DCEL3D& i_DCEL, bool i_KeepPolygons)
+{
+    Mesh mesh;
+    std::unordered_map<const Point*, uint> vertexOfPt;
+
+    // For each facet
+    for (const sptr<Facet>& facet : i_DCEL.m_Facets) {
+        if (!facet) {
+            continue;
+        }
+
+        // Number its vertices
+        std::vector<uint> vertices;
+        sptr<HalfEdge> edge(facet->m_AnEdge);
+        do {
+            const Point* pt(edge->m_Origin.get());
+            auto inserted(vertexOfPt.emplace(pt, mesh.nbVertices()));
+            if (inserted.second) {
+                mesh.m_Positions.push_back(pt->m_x);
+                mesh.m_Positions.push_back(pt->m_y);
+                mesh.m_Positions.push_back(pt->m_z);
+            }
+            vertices.push_back(inserted.first->second);
+            edge = edge->m_Next;
+        } while (edge != facet->m_AnEdge);
+
+        // Fan triangulation
+        uint facetIdx(mesh.nbFacets());
+        for (uint i = 1; i + 1 < vertices.size(); ++i) {
+            mesh.m_Triangles.push_back(vertices[0]);
+            mesh.m_Triangles.push_back(vertices[i]);
+            mesh.m_Triangles.push_back(vertices[i + 1]);
+            mesh.m_FacetOfTriangle.push_back(facetIdx);
+        }
+
+        if (i_KeepPolygons) {
+            mesh.m_PolygonStarts.push_back(mesh.m_Polygons.size());
+            mesh.m_Polygons.insert(mesh.m_Polygons.end(), vertices.begin(), vertices.end());
+        }
+
+        // Unit normal
+        Vector normal(facet->m_Normal.normalize());
+        mesh.m_Normals.push_back(normal.m_x);
+        mesh.m_Normals.push_back(normal.m_y);
+        mesh.m_Normals.push_back(normal.m_z);
+    }
+
+    if (i_KeepPolygons) {
+        mesh.m_PolygonStarts.push_back(mesh.m_Polygons.size());
+    }
+
+    return mesh;
+}
+
+Mesh exportMesh(const DegenerateHull& i_Hull, const std::vector<sPoint>& i_Pts)
+{
+    Mesh mesh;
+
+    for (uint index : i_Hull.m_Vertices) {
+        mesh.m_Positions.push_back(i_Pts[index]->m_x);
+        mesh.m_Positions.push_back(i_Pts[index]->m_y);
+        mesh.m_Positions.push_back(i_Pts[index]->m_z);
+    }
+
+    // The polygon is a single facet
+    if (i_Hull.m_Dimension == 2) {
+        for (uint i = 1; i + 1 < i_Hull.m_Vertices.size(); ++i) {
+            mesh.m_Triangles.push_back(0);
+            mesh.m_Triangles.push_back(i);
+            mesh.m_Triangles.push_back(i + 1);
+            mesh.m_FacetOfTriangle.push_back(0);
+        }
+        mesh.m_Normals.push_back(i_Hull.m_Normal.m_x);
+        mesh.m_Normals.push_back(i_Hull.m_Normal.m_y);
+        mesh.m_Normals.push_back(i_Hull.m_Normal.m_z);
+    }
+
+    return mesh;
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#ifndef __Mesh__
+#define __Mesh__
+
+#include <vector>
+
+#include "DCEL3D.h"
+#include "Degeneracy.h"
+
+// Compact indexed triangle mesh of a hull, for rendering and export. Facets
+// with more than three edges are fan triangulated, so a facet can own several
+// consecutive triangles.
+struct Mesh
+{
+    std::vector<double> m_Positions;      // x, y, z of each vertex
+    std::vector<uint>   m_Triangles;      // 3 vertices per triangle, CCW seen from outside
+    std::vector<uint>   m_FacetOfTriangle;
+    std::vector<double> m_Normals;        // Unit outward x, y, z of each facet
+
+    // Optional polygons: vertices of facet f are m_Polygons[m_PolygonStarts[f]]
+    // to m_Polygons[m_PolygonStarts[f + 1]] (excluded), CCW seen from outside
+    std::vector<uint>   m_Polygons;
+    std::vector<uint>   m_PolygonStarts;
+
+    uint nbVertices() const { return m_Positions.size() / 3; }
+    uint nbTriangles() const { return m_Triangles.size() / 3; }
+    uint nbFacets() const { return m_Normals.size() / 3; }
+    bool hasPolygons() const { return !m_PolygonStarts.empty(); }
+};
+
+// Numbers the vertices of the DCEL (each point once) and triangulates its
+// facets. Facets are also kept as polygons if requested.
+Mesh exportMesh(const DCEL3D& i_DCEL, bool i_KeepPolygons = false);
+
+// Same for the hull of flat input (only a polygon has triangles)
+Mesh exportMesh(const DegenerateHull& i_Hull, const std::vector<sPoint>& i_Pts);
+
+#endif
\ No newline at end of file
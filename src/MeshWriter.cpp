@@ -0,0 +1,354 @@
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "MeshWriter.h"
+
+/************************************************************************/
+/*                            BufferedFile                              */
+/************************************************************************/
+
+struct BufferedFile
+{
+    FILE*             m_File;
+    std::vector<char> m_Buffer;
+    size_t            m_Size;
+    bool              m_Failed;
+
+    BufferedFile(const std::string& i_Filepath) :
+        m_File(fopen(i_Filepath.c_str(), "wb")),
+        m_Buffer(1 << 22),
+        m_Size(0),
+        m_Failed(!m_File)
+    {
+        if (!m_File) {
+            std::cerr << "Could not open \"" << i_Filepath << "\" for writing" << std::endl;
+        }
+    }
+
+    ~BufferedFile()
+    {
+        close();
+    }
+
+    // Room for at least i_Size (at most the buffer size) more bytes
+    char* reserve(size_t i_Size)
+    {
+        if (m_Size + i_Size > m_Buffer.size()) {
+            flush();
+        }
+        return &m_Buffer[m_Size];
+    }
+
+    void write(const void* i_Data, size_t i_Size)
+    {
+        // Too large to be buffered
+        if (i_Size > m_Buffer.size()) {
+            flush();
+            if (m_File && fwrite(i_Data, 1, i_Size, m_File) != i_Size) {
+                m_Failed = true;
+            }
+            return;
+        }
+        memcpy(reserve(i_Size), i_Data, i_Size);
+        m_Size += i_Size;
+    }
+
+    void write(const std::string& i_String)
+    {
+        write(i_String.data(), i_String.size());
+    }
+
+    template <typename T>
+    void writeBinary(T i_Value)
+    {
+        write(&i_Value, sizeof(T));
+    }
+
+    void flush()
+    {
+        if (m_File && m_Size > 0 && fwrite(m_Buffer.data(), 1, m_Size, m_File) != m_Size) {
+            m_Failed = true;
+        }
+        m_Size = 0;
+    }
+
+    // Returns false if anything went wrong
+    bool close()
+    {
+        if (m_File) {
+            flush();
+            m_Failed |= fclose(m_File) != 0;
+            m_File = NULL;
+        }
+        return !m_Failed;
+    }
+};
+
+
+/************************************************************************/
+/*                          Number formatting                           */
+/************************************************************************/
+
+// Writes the decimal digits of i_Value, returns the end of the output
+static char* formatUInt(unsigned long long i_Value, char* o_Str)
+{
+    char digits[20];
+    int nbDigits(0);
+    do {
+        digits[nbDigits++] = char('0' + i_Value % 10);
+        i_Value /= 10;
+    } while (i_Value > 0);
+
+    while (nbDigits > 0) {
+        *o_Str++ = digits[--nbDigits];
+    }
+    return o_Str;
+}
+
+// Writes i_Value with 12 significant digits (half a unit of the last digit,
+// so a relative error up to 5e-12), without exponent for usual magnitudes.
+// Returns the end of the output.
+static char* formatDouble(double i_Value, char* o_Str)
+{
+    static const int NB_DIGITS = 12;
+
+    // 1e-5 to 1e16 (s_PowersOf10[i] is 10^(i - 5))
+    static const double s_PowersOf10[] = {
+        1e-5, 1e-4, 1e-3, 1e-2, 1e-1, 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+        1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16
+    };
+
+    if (i_Value == 0 || !std::isfinite(i_Value)) {
+        return o_Str + sprintf(o_Str, "%g", i_Value == 0 ? 0.0 : i_Value);
+    }
+
+    if (i_Value < 0) {
+        *o_Str++ = '-';
+        i_Value = -i_Value;
+    }
+
+    // Other magnitudes are rare in practice
+    if (i_Value < 1e-5 || i_Value >= 1e15) {
+        return o_Str + sprintf(o_Str, "%.*g", NB_DIGITS, i_Value);
+    }
+
+    // Decimal exponent, fixed when the mantissa rounds up to a power of ten
+    int exponent(15);
+    while (i_Value < s_PowersOf10[exponent + 5]) {
+        --exponent;
+    }
+    int shift(NB_DIGITS - 1 - exponent);
+    unsigned long long mantissa(llround(i_Value * s_PowersOf10[shift + 5]));
+    if (mantissa == 1000000000000ULL) {
+        mantissa /= 10;
+        ++exponent;
+    }
+
+    char digits[NB_DIGITS + 1];
+    char* end(formatUInt(mantissa, digits));
+    int nbDigits(int(end - digits));
+
+    // Drop trailing zeros of the fractional part
+    int nbIntegerDigits(exponent + 1);
+    while (nbDigits > (std::max)(nbIntegerDigits, 0) && digits[nbDigits - 1] == '0') {
+        --nbDigits;
+    }
+
+    if (nbIntegerDigits <= 0) {
+        // 0.000ddd
+        *o_Str++ = '0';
+        *o_Str++ = '.';
+        for (int i = 0; i < -nbIntegerDigits; ++i) {
+            *o_Str++ = '0';
+        }
+        memcpy(o_Str, digits, nbDigits);
+        return o_Str + nbDigits;
+    }
+
+    // ddd.ddd or dddd000
+    for (int i = 0; i < nbIntegerDigits; ++i) {
+        *o_Str++ = i < nbDigits ? digits[i] : '0';
+    }
+    if (nbDigits > nbIntegerDigits) {
+        *o_Str++ = '.';
+        memcpy(o_Str, digits + nbIntegerDigits, nbDigits - nbIntegerDigits);
+        o_Str += nbDigits - nbIntegerDigits;
+    }
+    return o_Str;
+}
+
+
+/************************************************************************/
+/*                               Writers                                */
+/************************************************************************/
+
+bool writeOBJ(const Mesh& i_Mesh, const std::string& i_Filepath)
+{
+    BufferedFile file(i_Filepath);
+    file.write("# Convex hull: " + std::to_string(i_Mesh.nbVertices()) + " vertices, " +
+               std::to_string(i_Mesh.nbFacets()) + " facets\n");
+
+    // Vertices
+    for (uint vertex = 0; vertex < i_Mesh.nbVertices(); ++vertex) {
+        char* str(file.reserve(128));
+        char* begin(str);
+        *str++ = 'v';
+        for (int axis = 0; axis < 3; ++axis) {
+            *str++ = ' ';
+            str = formatDouble(i_Mesh.m_Positions[3 * vertex + axis], str);
+        }
+        *str++ = '\n';
+        file.m_Size += str - begin;
+    }
+
+    // Facet normals, then faces (indices start at 1)
+    for (uint facet = 0; facet < i_Mesh.nbFacets(); ++facet) {
+        char* str(file.reserve(128));
+        char* begin(str);
+        *str++ = 'v';
+        *str++ = 'n';
+        for (int axis = 0; axis < 3; ++axis) {
+            *str++ = ' ';
+            str = formatDouble(i_Mesh.m_Normals[3 * facet + axis], str);
+        }
+        *str++ = '\n';
+        file.m_Size += str - begin;
+    }
+
+    // Corners are written one by one, polygons can be large
+    auto writeFace = [&file](const uint* i_Vertices, uint i_NbVertices, uint i_Normal) {
+        for (uint corner = 0; corner < i_NbVertices; ++corner) {
+            char* str(file.reserve(32));
+            char* begin(str);
+            if (corner == 0) {
+                *str++ = 'f';
+            }
+            *str++ = ' ';
+            str = formatUInt(i_Vertices[corner] + 1, str);
+            *str++ = '/';
+            *str++ = '/';
+            str = formatUInt(i_Normal + 1, str);
+            if (corner + 1 == i_NbVertices) {
+                *str++ = '\n';
+            }
+            file.m_Size += str - begin;
+        }
+    };
+
+    if (i_Mesh.hasPolygons()) {
+        for (uint facet = 0; facet < i_Mesh.nbFacets(); ++facet) {
+            uint start(i_Mesh.m_PolygonStarts[facet]);
+            writeFace(&i_Mesh.m_Polygons[start], i_Mesh.m_PolygonStarts[facet + 1] - start, facet);
+        }
+    } else {
+        for (uint triangle = 0; triangle < i_Mesh.nbTriangles(); ++triangle) {
+            writeFace(&i_Mesh.m_Triangles[3 * triangle], 3, i_Mesh.m_FacetOfTriangle[triangle]);
+        }
+    }
+
+    return file.close();
+}
+
+bool writePLY(const Mesh& i_Mesh, const std::string& i_Filepath)
+{
+    // Data is written in the byte order of the machine
+    const unsigned short one(1);
+    bool isLittleEndian(*(const unsigned char*)&one == 1);
+
+    // Faces are triangles or polygons
+    uint nbFaces(i_Mesh.hasPolygons() ? i_Mesh.nbFacets() : i_Mesh.nbTriangles());
+    uint maxFaceSize(3);
+    for (uint facet = 0; i_Mesh.hasPolygons() && facet < i_Mesh.nbFacets(); ++facet) {
+        maxFaceSize = (std::max)(maxFaceSize, i_Mesh.m_PolygonStarts[facet + 1] - i_Mesh.m_PolygonStarts[facet]);
+    }
+    bool hasSmallFaces(maxFaceSize <= 255);
+
+    BufferedFile file(i_Filepath);
+    file.write(std::string("ply\n") +
+               "format " + (isLittleEndian ? "binary_little_endian" : "binary_big_endian") + " 1.0\n" +
+               "element vertex " + std::to_string(i_Mesh.nbVertices()) + "\n" +
+               "property double x\n"
+               "property double y\n"
+               "property double z\n"
+               "element face " + std::to_string(nbFaces) + "\n" +
+               "property list " + (hasSmallFaces ? "uchar" : "uint") + " uint vertex_indices\n" +
+               "end_header\n");
+
+    // Vertices are already laid out as PLY wants them
+    file.write(i_Mesh.m_Positions.data(), i_Mesh.m_Positions.size() * sizeof(double));
+
+    for (uint face = 0; face < nbFaces; ++face) {
+        uint start(i_Mesh.hasPolygons() ? i_Mesh.m_PolygonStarts[face] : 3 * face);
+        uint size(i_Mesh.hasPolygons() ? i_Mesh.m_PolygonStarts[face + 1] - start : 3);
+        if (hasSmallFaces) {
+            file.writeBinary<unsigned char>(size);
+        } else {
+            file.writeBinary<unsigned int>(size);
+        }
+        file.write(&(i_Mesh.hasPolygons() ? i_Mesh.m_Polygons : i_Mesh.m_Triangles)[start], size * sizeof(uint));
+    }
+
+    return file.close();
+}
+
+bool writeSTL(const Mesh& i_Mesh, const std::string& i_Filepath)
+{
+    BufferedFile file(i_Filepath);
+
+    // 80 bytes header, then the number of triangles
+    char header[80];
+    memset(header, 0, sizeof(header));
+    strncpy(header, "Convex hull", sizeof(header));
+    file.write(header, sizeof(header));
+    file.writeBinary<unsigned int>(i_Mesh.nbTriangles());
+
+    // Normal, 3 corners and an unused attribute (50 bytes) per triangle
+    for (uint triangle = 0; triangle < i_Mesh.nbTriangles(); ++triangle) {
+        float data[12];
+        const double* normal(&i_Mesh.m_Normals[3 * i_Mesh.m_FacetOfTriangle[triangle]]);
+        for (int axis = 0; axis < 3; ++axis) {
+            data[axis] = float(normal[axis]);
+        }
+        for (int corner = 0; corner < 3; ++corner) {
+            const double* position(&i_Mesh.m_Positions[3 * i_Mesh.m_Triangles[3 * triangle + corner]]);
+            for (int axis = 0; axis < 3; ++axis) {
+                data[3 + 3 * corner + axis] = float(position[axis]);
+            }
+        }
+        file.write(data, sizeof(data));
+        file.writeBinary<unsigned short>(0);
+    }
+
+    return file.close();
+}
+
+bool writeMesh(const Mesh& i_Mesh, const std::string& i_Filepath)
+{
+    // The last '.' of the file name, not of a directory
+    size_t dot(i_Filepath.rfind('.'));
+    size_t separator(i_Filepath.find_last_of("/\\"));
+    if (dot == std::string::npos || (separator != std::string::npos && dot < separator)) {
+        std::cerr << "No extension in \"" << i_Filepath << "\" (expected .obj, .ply or .stl)" << std::endl;
+        return false;
+    }
+    std::string extension(i_Filepath.substr(dot + 1));
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+    if (extension == "obj") {
+        return writeOBJ(i_Mesh, i_Filepath);
+    }
+    if (extension == "ply") {
+        return writePLY(i_Mesh, i_Filepath);
+    }
+    if (extension == "stl") {
+        return writeSTL(i_Mesh, i_Filepath);
+    }
+
+    std::cerr << "Unknown mesh format \"" << extension << "\" (expected obj, ply or stl)" << std::endl;
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#ifndef __MeshWriter__
+#define __MeshWriter__
+
+#include <string>
+
+#include "Mesh.h"
+
+// Writers of the hull mesh. Only hull vertices are written, with the indices
+// of the mesh. OBJ and PLY write polygons when the mesh has them, STL always
+// writes triangles. Files are written through a large buffer and numbers are
+// formatted without stdio, so writing is I/O bound. Return false if the file
+// could not be written.
+bool writeOBJ(const Mesh& i_Mesh, const std::string& i_Filepath);
+bool writePLY(const Mesh& i_Mesh, const std::string& i_Filepath);    // Binary, double coordinates
+bool writeSTL(const Mesh& i_Mesh, const std::string& i_Filepath);    // Binary, float coordinates
+
+// Picks the writer from the extension (.obj, .ply or .stl)
+bool writeMesh(const Mesh& i_Mesh, const std::string& i_Filepath);
+
+#endif
\ No newline at end of file
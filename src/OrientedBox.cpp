@@ -0,0 +1,329 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+#include "Degeneracy.h"
+#include "OrientedBox.h"
+#include "Parallel.h"
+
+// Candidate axes closer than this are tried once
+#define AXIS_TOLERANCE 1e-12
+
+// Spreads sampled directions evenly (pi * (3 - sqrt(5)))
+#define GOLDEN_ANGLE 2.39996322972865332223
+
+// Refinement rounds of the approximate box
+#define MAX_REFINEMENT_ROUNDS 8
+
+// Flips the axis so that its largest coordinate is positive (a box around an
+// axis is also around its opposite)
+static Vector canonicalAxis(const Vector& i_Axis)
+{
+    Vector axis(i_Axis.normalize());
+    int largest(0);
+    for (int i = 1; i < 3; ++i) {
+        if (fabs(axis[i]) > fabs(axis[largest])) {
+            largest = i;
+        }
+    }
+    return axis[largest] < 0 ? -axis : axis;
+}
+
+// Sorts the axes and removes near duplicates
+static void removeDuplicateAxes(std::vector<Vector>& io_Axes)
+{
+    std::sort(io_Axes.begin(), io_Axes.end(), [](const Vector& i_A, const Vector& i_B) {
+        return i_A.m_x < i_B.m_x || (i_A.m_x == i_B.m_x && (i_A.m_y < i_B.m_y ||
+               (i_A.m_y == i_B.m_y && i_A.m_z < i_B.m_z)));
+    });
+    io_Axes.erase(std::unique(io_Axes.begin(), io_Axes.end(), [](const Vector& i_A, const Vector& i_B) {
+        return (i_A - i_B).squareNorm() < AXIS_TOLERANCE * AXIS_TOLERANCE;
+    }), io_Axes.end());
+}
+
+// Indices of the 2D convex hull of the points, counter-clockwise (Andrew's
+// monotone chain)
+static std::vector<uint> computeHull2D(const std::vector<double>& i_U, const std::vector<double>& i_V)
+{
+    uint nbPts(i_U.size());
+    std::vector<uint> sorted(nbPts);
+    for (uint i = 0; i < nbPts; ++i) {
+        sorted[i] = i;
+    }
+    std::sort(sorted.begin(), sorted.end(), [&](uint i_A, uint i_B) {
+        return i_U[i_A] < i_U[i_B] || (i_U[i_A] == i_U[i_B] && i_V[i_A] < i_V[i_B]);
+    });
+
+    auto turn = [&](uint i_A, uint i_B, uint i_C) {
+        return (i_U[i_B] - i_U[i_A]) * (i_V[i_C] - i_V[i_A]) - (i_V[i_B] - i_V[i_A]) * (i_U[i_C] - i_U[i_A]);
+    };
+
+    std::vector<uint> chain(2 * nbPts + 1);
+    uint k(0);
+    for (uint i = 0; i < nbPts; ++i) {
+        while (k >= 2 && turn(chain[k - 2], chain[k - 1], sorted[i]) <= 0) {
+            --k;
+        }
+        chain[k++] = sorted[i];
+    }
+    for (uint i = nbPts - 1, lowerSize = k + 1; i > 0; --i) {
+        while (k >= lowerSize && turn(chain[k - 2], chain[k - 1], sorted[i - 1]) <= 0) {
+            --k;
+        }
+        chain[k++] = sorted[i - 1];
+    }
+    chain.resize(k > 1 ? k - 1 : k);
+    return chain;
+}
+
+/************************************************************************/
+/*                            HullBoxFitter                             */
+/************************************************************************/
+
+HullBoxFitter::HullBoxFitter(const DCEL3D& i_Hull)
+{
+    // Number vertices, facets and edges (each edge once, from the half-edge
+    // that comes first)
+    std::unordered_map<const Point*, uint> indexOfPt;
+    std::unordered_map<const HalfEdge*, uint> edgeOfTwin;
+    std::vector<sPoint> vertices;
+    uint facetIdx(0);
+    for (const sptr<Facet>& facet : i_Hull.m_Facets) {
+        if (!facet) {
+            continue;
+        }
+        Vector normal(facet->m_Normal.normalize());
+        m_NormalsX.push_back(normal.m_x);
+        m_NormalsY.push_back(normal.m_y);
+        m_NormalsZ.push_back(normal.m_z);
+
+        const HalfEdge* first(facet->m_AnEdge.get());
+        const HalfEdge* edge(first);
+        do {
+            auto inserted(indexOfPt.emplace(edge->m_Origin.get(), vertices.size()));
+            if (inserted.second) {
+                vertices.push_back(edge->m_Origin);
+            }
+
+            auto twin(edgeOfTwin.find(edge));
+            if (twin == edgeOfTwin.end()) {
+                HullEdge hullEdge = {{inserted.first->second, 0}, {facetIdx, 0}};
+                edgeOfTwin.emplace(edge->m_Twin.get(), m_Edges.size());
+                m_Edges.push_back(hullEdge);
+            } else {
+                m_Edges[twin->second].m_Facets[1] = facetIdx;
+                m_Edges[twin->second].m_Vertices[1] = inserted.first->second;
+            }
+            edge = edge->m_Next.get();
+        } while (edge != first);
+        ++facetIdx;
+    }
+
+    for (const sPoint& vertex : vertices) {
+        m_X.push_back(vertex->m_x);
+        m_Y.push_back(vertex->m_y);
+        m_Z.push_back(vertex->m_z);
+    }
+
+    FlatnessInfo info(analyzeFlatness(vertices, 0));
+    for (int i = 0; i < 3; ++i) {
+        m_PrincipalAxes[i] = info.m_Axes[i];
+    }
+}
+
+OrientedBox HullBoxFitter::fitAroundAxis(const Vector& i_Axis) const
+{
+    // Frame (u, v, w) with w along the axis
+    Vector w(i_Axis.normalize());
+    Vector u(cross(w, fabs(w.m_x) < 0.9 ? Vector(1, 0, 0) : Vector(0, 1, 0)).normalize());
+    Vector v(cross(w, u));
+
+    // Which way facets face
+    uint nbFacets(m_NormalsX.size());
+    std::vector<char> isFront(nbFacets);
+    for (uint f = 0; f < nbFacets; ++f) {
+        isFront[f] = m_NormalsX[f] * w.m_x + m_NormalsY[f] * w.m_y + m_NormalsZ[f] * w.m_z >= 0;
+    }
+
+    // Silhouette vertices in the (u, v) plane
+    std::vector<double> silhouetteU, silhouetteV;
+    for (const HullEdge& edge : m_Edges) {
+        if (isFront[edge.m_Facets[0]] == isFront[edge.m_Facets[1]]) {
+            continue;
+        }
+        for (uint vertex : edge.m_Vertices) {
+            silhouetteU.push_back(u.m_x * m_X[vertex] + u.m_y * m_Y[vertex] + u.m_z * m_Z[vertex]);
+            silhouetteV.push_back(v.m_x * m_X[vertex] + v.m_y * m_Y[vertex] + v.m_z * m_Z[vertex]);
+        }
+    }
+
+    // Extent along the axis
+    double minW(std::numeric_limits<double>::max());
+    double maxW(-std::numeric_limits<double>::max());
+    for (uint i = 0; i < m_X.size(); ++i) {
+        double coord(w.m_x * m_X[i] + w.m_y * m_Y[i] + w.m_z * m_Z[i]);
+        minW = coord < minW ? coord : minW;
+        maxW = coord > maxW ? coord : maxW;
+    }
+
+    // Rotating calipers: the minimum area rectangle has a side along an edge
+    // of the silhouette. For each edge, the extreme vertices along it, against
+    // it and away from it only move forward.
+    std::vector<uint> hull(computeHull2D(silhouetteU, silhouetteV));
+
+    // Edges along the axis project to nearly coincident points, whose noisy
+    // direction would throw the calipers off
+    double size(0);
+    for (uint pt : hull) {
+        size = (std::max)(size, (std::max)(fabs(silhouetteU[pt] - silhouetteU[hull[0]]),
+                                           fabs(silhouetteV[pt] - silhouetteV[hull[0]])));
+    }
+    uint nbHullPts(0);
+    for (uint i = 0; i < hull.size(); ++i) {
+        uint previous(nbHullPts > 0 ? hull[nbHullPts - 1] : hull.back());
+        if (i == 0 || (std::max)(fabs(silhouetteU[hull[i]] - silhouetteU[previous]),
+                                 fabs(silhouetteV[hull[i]] - silhouetteV[previous])) > AXIS_TOLERANCE * size) {
+            hull[nbHullPts++] = hull[i];
+        }
+    }
+    hull.resize(nbHullPts);
+    auto along = [&](uint i_Pt, double i_DirU, double i_DirV) {
+        return silhouetteU[hull[i_Pt]] * i_DirU + silhouetteV[hull[i_Pt]] * i_DirV;
+    };
+
+    double bestArea(std::numeric_limits<double>::max());
+    double bestDir[2] = {1, 0};
+    double bestRange[2][2] = {{0, 0}, {0, 0}};
+    uint right(0), top(0), left(0);
+    bool isInitialized(false);
+    for (uint i = 0; i < nbHullPts && nbHullPts >= 3; ++i) {
+        uint next((i + 1) % nbHullPts);
+        double dirU(silhouetteU[hull[next]] - silhouetteU[hull[i]]);
+        double dirV(silhouetteV[hull[next]] - silhouetteV[hull[i]]);
+        double length(sqrt(dirU * dirU + dirV * dirV));
+        dirU /= length;
+        dirV /= length;
+        // Inward normal of a counter-clockwise edge
+        double normalU(-dirV), normalV(dirU);
+
+        if (!isInitialized) {
+            for (uint j = 1; j < nbHullPts; ++j) {
+                right = along(j, dirU, dirV) > along(right, dirU, dirV) ? j : right;
+                left = along(j, dirU, dirV) < along(left, dirU, dirV) ? j : left;
+                top = along(j, normalU, normalV) > along(top, normalU, normalV) ? j : top;
+            }
+            isInitialized = true;
+        }
+        while (along((right + 1) % nbHullPts, dirU, dirV) > along(right, dirU, dirV)) {
+            right = (right + 1) % nbHullPts;
+        }
+        while (along((top + 1) % nbHullPts, normalU, normalV) > along(top, normalU, normalV)) {
+            top = (top + 1) % nbHullPts;
+        }
+        while (along((left + 1) % nbHullPts, dirU, dirV) < along(left, dirU, dirV)) {
+            left = (left + 1) % nbHullPts;
+        }
+
+        double width(along(right, dirU, dirV) - along(left, dirU, dirV));
+        double height(along(top, normalU, normalV) - along(i, normalU, normalV));
+        if (width * height < bestArea) {
+            bestArea = width * height;
+            bestDir[0] = dirU;
+            bestDir[1] = dirV;
+            bestRange[0][0] = along(left, dirU, dirV);
+            bestRange[0][1] = along(right, dirU, dirV);
+            bestRange[1][0] = along(i, normalU, normalV);
+            bestRange[1][1] = along(top, normalU, normalV);
+        }
+    }
+
+    // Extents along the chosen direction from every silhouette point, which
+    // also covers flat silhouettes (numerical corner case)
+    for (int i = 0; i < 2 && !silhouetteU.empty(); ++i) {
+        double dirU(i == 0 ? bestDir[0] : -bestDir[1]);
+        double dirV(i == 0 ? bestDir[1] : bestDir[0]);
+        bestRange[i][0] = std::numeric_limits<double>::max();
+        bestRange[i][1] = -std::numeric_limits<double>::max();
+        for (uint pt = 0; pt < silhouetteU.size(); ++pt) {
+            double coord(silhouetteU[pt] * dirU + silhouetteV[pt] * dirV);
+            bestRange[i][0] = (std::min)(bestRange[i][0], coord);
+            bestRange[i][1] = (std::max)(bestRange[i][1], coord);
+        }
+    }
+
+    OrientedBox box;
+    box.m_Axes[0] = u * bestDir[0] + v * bestDir[1];
+    box.m_Axes[1] = u * -bestDir[1] + v * bestDir[0];
+    box.m_Axes[2] = w;
+    double centerCoords[3] = {(bestRange[0][0] + bestRange[0][1]) / 2, (bestRange[1][0] + bestRange[1][1]) / 2,
+                              (minW + maxW) / 2};
+    box.m_HalfExtents[0] = (bestRange[0][1] - bestRange[0][0]) / 2;
+    box.m_HalfExtents[1] = (bestRange[1][1] - bestRange[1][0]) / 2;
+    box.m_HalfExtents[2] = (maxW - minW) / 2;
+    box.m_Center = Point(0, 0, 0);
+    for (int i = 0; i < 3; ++i) {
+        box.m_Center += box.m_Axes[i] * centerCoords[i];
+    }
+    return box;
+}
+
+OrientedBox HullBoxFitter::fitAroundAxes(const std::vector<Vector>& i_Axes) const
+{
+    std::vector<OrientedBox> bestOfThread(nbThreads());
+    std::vector<double> bestVolumeOfThread(nbThreads(), std::numeric_limits<double>::max());
+    parallelFor(0, i_Axes.size(), [&](uint i_ThreadID, uint i_Begin, uint i_End) {
+        for (uint i = i_Begin; i < i_End; ++i) {
+            OrientedBox box(fitAroundAxis(i_Axes[i]));
+            if (box.volume() < bestVolumeOfThread[i_ThreadID]) {
+                bestVolumeOfThread[i_ThreadID] = box.volume();
+                bestOfThread[i_ThreadID] = box;
+            }
+        }
+    });
+
+    uint best(std::min_element(bestVolumeOfThread.begin(), bestVolumeOfThread.end()) - bestVolumeOfThread.begin());
+    return bestOfThread[best];
+}
+
+OrientedBox HullBoxFitter::computeMinimumBox() const
+{
+    std::vector<Vector> axes;
+    for (uint f = 0; f < m_NormalsX.size(); ++f) {
+        axes.push_back(canonicalAxis(Vector(m_NormalsX[f], m_NormalsY[f], m_NormalsZ[f])));
+    }
+    for (const HullEdge& edge : m_Edges) {
+        uint a(edge.m_Vertices[0]), b(edge.m_Vertices[1]);
+        axes.push_back(canonicalAxis(Vector(m_X[b] - m_X[a], m_Y[b] - m_Y[a], m_Z[b] - m_Z[a])));
+    }
+    removeDuplicateAxes(axes);
+    return refine(fitAroundAxes(axes));
+}
+
+OrientedBox HullBoxFitter::computeApproximateBox(uint i_NbDirections) const
+{
+    std::vector<Vector> axes(m_PrincipalAxes, m_PrincipalAxes + 3);
+
+    // Fibonacci lattice on the upper half sphere (opposite axes give the same
+    // boxes)
+    for (uint i = 0; i < i_NbDirections; ++i) {
+        double z(1 - (i + 0.5) / i_NbDirections);
+        double radius(sqrt(1 - z * z));
+        axes.push_back(Vector(radius * cos(GOLDEN_ANGLE * i), radius * sin(GOLDEN_ANGLE * i), z));
+    }
+    return refine(fitAroundAxes(axes));
+}
+
+OrientedBox HullBoxFitter::refine(const OrientedBox& i_Box) const
+{
+    // Fitting around an axis of the box re-optimizes the rotation about it
+    OrientedBox best(i_Box);
+    for (uint round = 0; round < MAX_REFINEMENT_ROUNDS; ++round) {
+        OrientedBox refined(fitAroundAxes(std::vector<Vector>(best.m_Axes, best.m_Axes + 3)));
+        if (refined.volume() >= best.volume()) {
+            break;
+        }
+        best = refined;
+    }
+    return best;
+}
\ No newline at end of file
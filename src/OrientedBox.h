@@ -0,0 +1,65 @@
+#ifndef __OrientedBox__
+#define __OrientedBox__
+
+#include <vector>
+
+#include "DCEL3D.h"
+
+struct OrientedBox
+{
+    Point  m_Center;
+    Vector m_Axes[3];            // Unit and orthogonal
+    double m_HalfExtents[3];
+
+    double volume() const { return 8 * m_HalfExtents[0] * m_HalfExtents[1] * m_HalfExtents[2]; }
+};
+
+// Edge of the hull with the facets on each side
+struct HullEdge
+{
+    uint m_Vertices[2];
+    uint m_Facets[2];
+};
+
+// Small oriented bounding boxes of a built hull, looking only at hull
+// vertices. For a given axis, the best box is found from the silhouette of
+// the hull along that axis (edges between facets facing either way), whose
+// minimum area rectangle is found by rotating calipers. Candidate axes are
+// tried in parallel.
+struct HullBoxFitter
+{
+    std::vector<double>   m_X;             // Hull vertices
+    std::vector<double>   m_Y;
+    std::vector<double>   m_Z;
+    std::vector<double>   m_NormalsX;      // Unit facet normals
+    std::vector<double>   m_NormalsY;
+    std::vector<double>   m_NormalsZ;
+    std::vector<HullEdge> m_Edges;
+    Vector                m_PrincipalAxes[3];
+
+    HullBoxFitter(const DCEL3D& i_Hull);
+
+    // Smallest box having an axis along i_Axis
+    OrientedBox fitAroundAxis(const Vector& i_Axis) const;
+
+    // Smallest of the boxes around each axis
+    OrientedBox fitAroundAxes(const std::vector<Vector>& i_Axes) const;
+
+    // Heuristic for the minimum volume box: boxes with a face flush with a
+    // facet, or an axis along an edge (the calipers then make another face
+    // flush with a second edge), the best one being refined. The minimum box
+    // may instead have two adjacent faces flush with two edges and no axis
+    // along either (O'Rourke), which is not searched: the result can be
+    // larger. O(n) per candidate, so O(n^2) overall.
+    OrientedBox computeMinimumBox() const;
+
+    // Boxes around the principal axes of the hull vertices and around
+    // i_NbDirections directions spread over the sphere, the best one being
+    // refined. O(n) per candidate.
+    OrientedBox computeApproximateBox(uint i_NbDirections = 64) const;
+
+    // Fits again around each axis of i_Box until the volume stops decreasing
+    OrientedBox refine(const OrientedBox& i_Box) const;
+};
+
+#endif
\ No newline at end of file
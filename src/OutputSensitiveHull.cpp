@@ -0,0 +1,371 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_set>
+
+#include "OutputSensitiveHull.h"
+#include "Parallel.h"
+#include "SpaceFillingCurve.h"
+#include "TriangleMeshHull.h"
+
+#define NO_VERTEX uint(-1)
+
+/************************************************************************/
+/*                              SubHull                                 */
+/************************************************************************/
+
+uint SubHull::support(const Vector& i_Direction, const Point* i_Pts, uint& io_Hint) const
+{
+    if (m_Support) {
+        return m_Vertices[m_Support->support(i_Direction, io_Hint)];
+    }
+
+    uint best(m_Vertices[0]);
+    double bestValue(dot(i_Direction, i_Pts[best]));
+    for (uint vertex : m_Vertices) {
+        double value(dot(i_Direction, i_Pts[vertex]));
+        if (value > bestValue) {
+            bestValue = value;
+            best = vertex;
+        }
+    }
+    return best;
+}
+
+// Bounding box of the points of the group
+static void boundGroup(SubHull& io_Group, const Point* i_Pts)
+{
+    double min[3], max[3];
+    min[0] = max[0] = i_Pts[io_Group.m_Begin].m_x;
+    min[1] = max[1] = i_Pts[io_Group.m_Begin].m_y;
+    min[2] = max[2] = i_Pts[io_Group.m_Begin].m_z;
+    for (uint i = io_Group.m_Begin + 1; i < io_Group.m_End; ++i) {
+        const Point& pt(i_Pts[i]);
+        min[0] = (std::min)(min[0], pt.m_x);
+        max[0] = (std::max)(max[0], pt.m_x);
+        min[1] = (std::min)(min[1], pt.m_y);
+        max[1] = (std::max)(max[1], pt.m_y);
+        min[2] = (std::min)(min[2], pt.m_z);
+        max[2] = (std::max)(max[2], pt.m_z);
+    }
+    io_Group.m_Center = Point((min[0] + max[0]) / 2, (min[1] + max[1]) / 2, (min[2] + max[2]) / 2);
+    io_Group.m_HalfExtents = Vector((max[0] - min[0]) / 2, (max[1] - min[1]) / 2, (max[2] - min[2]) / 2);
+}
+
+static void buildGroup(SubHull& io_Group, const Point* i_Pts)
+{
+    const Point* pts(i_Pts + io_Group.m_Begin);
+    uint nbPts(io_Group.m_End - io_Group.m_Begin);
+    TriangleMeshHull hull(pts, nbPts);
+    if (hull.compute()) {
+        io_Group.m_Support.reset(new HullSupport(hull.m_Mesh, pts, io_Group.m_Vertices));
+        for (uint& vertex : io_Group.m_Vertices) {
+            vertex += io_Group.m_Begin;
+        }
+    } else {
+        for (uint i = io_Group.m_Begin; i < io_Group.m_End; ++i) {
+            io_Group.m_Vertices.push_back(i);
+        }
+    }
+    io_Group.m_IsBuilt = true;
+}
+
+// Is the bounding box of the group below every facet
+static bool isInside(const SubHull& i_Group, const TriangleMeshHull& i_Hull)
+{
+    for (uint facet = 0; facet < i_Hull.m_Normals.size(); ++facet) {
+        const Vector& normal(i_Hull.m_Normals[facet]);
+        double reach(fabs(normal.m_x) * i_Group.m_HalfExtents.m_x +
+                     fabs(normal.m_y) * i_Group.m_HalfExtents.m_y +
+                     fabs(normal.m_z) * i_Group.m_HalfExtents.m_z);
+        if (dot(normal, i_Group.m_Center) + reach >= i_Hull.m_Offsets[facet]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                              FacetKey                                */
+/************************************************************************/
+
+// Sorted candidate positions of the vertices of a facet, so that facets kept from
+// one round to the next are only asked once
+struct FacetKey
+{
+    uint m_Vertices[3];
+
+    bool operator==(const FacetKey& i_Other) const
+    {
+        return m_Vertices[0] == i_Other.m_Vertices[0] &&
+               m_Vertices[1] == i_Other.m_Vertices[1] &&
+               m_Vertices[2] == i_Other.m_Vertices[2];
+    }
+};
+
+struct FacetKeyHash
+{
+    size_t operator()(const FacetKey& i_Key) const
+    {
+        unsigned long long hash(0);
+        for (uint vertex : i_Key.m_Vertices) {
+            hash ^= vertex + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        }
+        return size_t(hash ^ (hash >> 32));
+    }
+};
+
+static FacetKey keyOf(const TriangleMesh& i_Mesh, uint i_Facet, const std::vector<uint>& i_Vertices)
+{
+    FacetKey key;
+    for (uint i = 0; i < 3; ++i) {
+        key.m_Vertices[i] = i_Vertices[i_Mesh.m_Origins[3 * i_Facet + i]];
+    }
+    std::sort(key.m_Vertices, key.m_Vertices + 3);
+    return key;
+}
+
+/************************************************************************/
+/*                         OutputSensitiveHull                          */
+/************************************************************************/
+
+OutputSensitiveHull::OutputSensitiveHull(const Point* i_Pts, uint i_NbPts) :
+    m_Pts(i_Pts),
+    m_NbPts(i_NbPts),
+    m_Mesh(),
+    m_Candidates(),
+    m_CandidatePts(),
+    m_GroupSize(0),
+    m_NbGuesses(0)
+{}
+
+bool OutputSensitiveHull::compute()
+{
+    m_NbGuesses = 0;
+    if (m_NbPts < 4) {
+        return false;
+    }
+    sortCandidates();
+
+    // Guesses are squared, so only O(log log h) of them are made. A guess
+    // that leaves most candidates means that the hull is large, then the
+    // next guess would not pay off.
+    for (unsigned long long groupSize = MIN_GROUP_SIZE; groupSize < m_Candidates.size(); groupSize *= groupSize) {
+        ++m_NbGuesses;
+        m_GroupSize = uint(groupSize);
+        uint nbCandidates(m_Candidates.size());
+        if (wrap(m_GroupSize)) {
+            return true;
+        }
+        if (m_Candidates.size() > nbCandidates / 2) {
+            break;
+        }
+    }
+
+    // A single group holds all candidates
+    ++m_NbGuesses;
+    m_GroupSize = m_Candidates.size();
+    return computeDirectly();
+}
+
+void OutputSensitiveHull::sortCandidates()
+{
+    std::vector<unsigned long long> codes(computeMortonCodes(m_Pts, m_NbPts));
+
+    // Counting sort on the top bits of the 63-bit codes
+    uint shift(63 - 3 * GROUP_OCTREE_LEVELS);
+    std::vector<uint> starts((1u << 3 * GROUP_OCTREE_LEVELS) + 1, 0);
+    for (unsigned long long code : codes) {
+        ++starts[(code >> shift) + 1];
+    }
+    for (uint cell = 1; cell < starts.size(); ++cell) {
+        starts[cell] += starts[cell - 1];
+    }
+    m_Candidates.resize(m_NbPts);
+    m_CandidatePts.resize(m_NbPts);
+    for (uint i = 0; i < m_NbPts; ++i) {
+        uint position(starts[codes[i] >> shift]++);
+        m_Candidates[position] = i;
+        m_CandidatePts[position] = m_Pts[i];
+    }
+}
+
+bool OutputSensitiveHull::computeDirectly()
+{
+    TriangleMeshHull hull(m_CandidatePts.data(), m_CandidatePts.size());
+    if (!hull.compute()) {
+        return false;
+    }
+    for (uint& vertex : hull.m_Mesh.m_Origins) {
+        vertex = m_Candidates[vertex];
+    }
+    m_Mesh = std::move(hull.m_Mesh);
+    return true;
+}
+
+bool OutputSensitiveHull::wrap(uint i_GroupSize)
+{
+    // Groups and their bounding boxes, their hulls are built when needed.
+    // Points are positions in the candidates from now on.
+    const Point* candidatePts(m_CandidatePts.data());
+    uint nbCandidates(m_Candidates.size());
+    uint nbGroups((nbCandidates - 1) / i_GroupSize + 1);
+    std::vector<SubHull> groups(nbGroups);
+    parallelFor(0, nbGroups, [&](uint, uint i_Begin, uint i_End) {
+        for (uint group = i_Begin; group < i_End; ++group) {
+            groups[group].m_Begin = group * i_GroupSize;
+            groups[group].m_End = (std::min)(nbCandidates, (group + 1) * i_GroupSize);
+            groups[group].m_IsBuilt = false;
+            groups[group].m_IsInside = false;
+            boundGroup(groups[group], candidatePts);
+        }
+    });
+    std::vector<uint> aliveGroups(nbGroups);
+    for (uint group = 0; group < nbGroups; ++group) {
+        aliveGroups[group] = group;
+    }
+
+    // Start from the candidates extreme along the axes and the diagonals
+    std::vector<Vector> directions;
+    for (int x = -1; x <= 1; ++x) {
+        for (int y = -1; y <= 1; ++y) {
+            for (int z = -1; z <= 1; ++z) {
+                if (x * x + y * y + z * z == 1 || x * x + y * y + z * z == 3) {
+                    directions.push_back(Vector(x, y, z));
+                }
+            }
+        }
+    }
+    std::vector<std::vector<uint>> extremes(nbThreads());
+    parallelFor(0, nbCandidates, [&](uint i_ThreadID, uint i_Begin, uint i_End) {
+        std::vector<uint> threadExtremes(directions.size(), i_Begin);
+        std::vector<double> values(directions.size(), -std::numeric_limits<double>::max());
+        for (uint i = i_Begin; i < i_End; ++i) {
+            const Point& pt(candidatePts[i]);
+            for (uint d = 0; d < directions.size(); ++d) {
+                double value(directions[d].m_x * pt.m_x + directions[d].m_y * pt.m_y + directions[d].m_z * pt.m_z);
+                if (value > values[d]) {
+                    values[d] = value;
+                    threadExtremes[d] = i;
+                }
+            }
+        }
+        extremes[i_ThreadID] = threadExtremes;
+    });
+
+    std::vector<uint> vertices;
+    std::vector<char> isFound(nbCandidates, 0);
+    for (uint d = 0; d < directions.size(); ++d) {
+        uint best(extremes[0][d]);
+        for (const std::vector<uint>& threadExtremes : extremes) {
+            if (!threadExtremes.empty() &&
+                dot(directions[d], candidatePts[threadExtremes[d]]) > dot(directions[d], candidatePts[best])) {
+                best = threadExtremes[d];
+            }
+        }
+        if (!isFound[best]) {
+            isFound[best] = 1;
+            vertices.push_back(best);
+        }
+    }
+
+    // Hill climbing hints of each thread in each group
+    std::vector<std::vector<uint>> hints(nbThreads(), std::vector<uint>(nbGroups, 0));
+    auto farthest = [&](const Vector& i_Direction, std::vector<uint>& io_Hints) {
+        uint best(NO_VERTEX);
+        double bestValue(-std::numeric_limits<double>::max());
+        for (uint group : aliveGroups) {
+            uint pt(groups[group].support(i_Direction, candidatePts, io_Hints[group]));
+            double value(dot(i_Direction, candidatePts[pt]));
+            if (value > bestValue) {
+                bestValue = value;
+                best = pt;
+            }
+        }
+        return best;
+    };
+
+    // Then ask each new facet of the hull of the points found so far for a
+    // point above it
+    std::unordered_set<FacetKey, FacetKeyHash> askedFacets;
+    while (vertices.size() <= i_GroupSize) {
+        std::vector<Point> pts(vertices.size());
+        for (uint i = 0; i < vertices.size(); ++i) {
+            pts[i] = candidatePts[vertices[i]];
+        }
+        TriangleMeshHull hull(pts.data(), pts.size());
+        if (!hull.compute()) {
+            break;
+        }
+
+        // Drop the groups that got inside, build the hulls of the others
+        parallelFor(0, aliveGroups.size(), [&](uint, uint i_Begin, uint i_End) {
+            for (uint i = i_Begin; i < i_End; ++i) {
+                SubHull& group(groups[aliveGroups[i]]);
+                group.m_IsInside = isInside(group, hull);
+                if (!group.m_IsInside && !group.m_IsBuilt) {
+                    buildGroup(group, candidatePts);
+                }
+            }
+        });
+        aliveGroups.erase(std::remove_if(aliveGroups.begin(), aliveGroups.end(), [&](uint i_Group) {
+            return groups[i_Group].m_IsInside;
+        }), aliveGroups.end());
+
+        std::vector<uint> facets;
+        for (uint facet = 0; facet < hull.m_Mesh.nbFacets(); ++facet) {
+            if (askedFacets.insert(keyOf(hull.m_Mesh, facet, vertices)).second) {
+                facets.push_back(facet);
+            }
+        }
+
+        std::vector<uint> found(facets.size());
+        parallelFor(0, facets.size(), [&](uint i_ThreadID, uint i_Begin, uint i_End) {
+            std::vector<uint>& threadHints(hints[i_ThreadID]);
+            for (uint i = i_Begin; i < i_End; ++i) {
+                uint pt(farthest(hull.m_Normals[facets[i]], threadHints));
+                bool isNew(pt != NO_VERTEX && !isFound[pt] && hull.isVisible(facets[i], candidatePts[pt]));
+                found[i] = isNew ? pt : NO_VERTEX;
+            }
+        });
+
+        // Done when no facet sees a new point
+        uint nbVertices(vertices.size());
+        for (uint pt : found) {
+            if (pt != NO_VERTEX && !isFound[pt]) {
+                isFound[pt] = 1;
+                vertices.push_back(pt);
+            }
+        }
+        if (vertices.size() == nbVertices) {
+            for (uint& vertex : hull.m_Mesh.m_Origins) {
+                vertex = m_Candidates[vertices[vertex]];
+            }
+            m_Mesh = std::move(hull.m_Mesh);
+            return true;
+        }
+    }
+
+    // Wrong guess. Only the hull vertices of the groups that were built and
+    // every point of those that were not can be hull vertices.
+    std::vector<uint> positions;
+    for (const SubHull& group : groups) {
+        if (group.m_IsInside) {
+            continue;
+        } else if (group.m_IsBuilt) {
+            positions.insert(positions.end(), group.m_Vertices.begin(), group.m_Vertices.end());
+        } else {
+            for (uint i = group.m_Begin; i < group.m_End; ++i) {
+                positions.push_back(i);
+            }
+        }
+    }
+    std::sort(positions.begin(), positions.end());
+    for (uint i = 0; i < positions.size(); ++i) {
+        m_Candidates[i] = m_Candidates[positions[i]];
+        m_CandidatePts[i] = m_CandidatePts[positions[i]];
+    }
+    m_Candidates.resize(positions.size());
+    m_CandidatePts.resize(positions.size());
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#ifndef __OutputSensitiveHull__
+#define __OutputSensitiveHull__
+
+#include <memory>
+#include <vector>
+
+#include "HullSupport.h"
+#include "TriangleMesh.h"
+
+// First guess of the number of hull vertices, squared after each failure
+#define MIN_GROUP_SIZE 256
+
+// Candidates are bucketed on this many levels of an octree (a counting sort
+// on the top bits of their Morton code) so that groups are compact
+#define GROUP_OCTREE_LEVELS 6
+
+// Group of consecutive candidates, with its hull once it is needed. Flat
+// groups have no hull and keep all their points, which are then searched
+// exhaustively.
+struct SubHull
+{
+    uint                         m_Begin;        // Range of candidate positions
+    uint                         m_End;
+    Point                        m_Center;       // Bounding box
+    Vector                       m_HalfExtents;
+    bool                         m_IsBuilt;
+    bool                         m_IsInside;     // Inside the hull found so far
+    std::unique_ptr<HullSupport> m_Support;
+    std::vector<uint>            m_Vertices;     // Candidate position of each vertex
+
+    // Candidate position of a point extreme in the direction (io_Hint as in
+    // HullSupport::support)
+    uint support(const Vector& i_Direction, const Point* i_Pts, uint& io_Hint) const;
+};
+
+// Output-sensitive hull in the style of Chan's algorithm, in O(n log h) for
+// h hull vertices. For a guess m of h, the input is split in groups of m
+// points whose hulls are computed in parallel by the triangle mesh engine.
+// The hull is then wrapped around the groups: starting from a few extreme
+// points, each facet of the hull of the points found so far asks every group
+// for its farthest point in the facet direction (O(log m) per group) and
+// points above facets are added until none is, each facet being asked once.
+// Once more than m points are found, the guess was too small and is squared,
+// the next guess only looking at the vertices of the hulls of the groups (or
+// the hull of those is computed directly when they are most of the points).
+// Groups are compact, so those whose bounding box gets inside the hull found
+// so far are dropped before their hull is even computed.
+struct OutputSensitiveHull
+{
+    // Input (not owned)
+    const Point*       m_Pts;
+    uint               m_NbPts;
+
+    // Hull (vertices are indices in the input)
+    TriangleMesh       m_Mesh;
+
+    // Input indices and coordinates of the points that may be hull
+    // vertices, in groups (copied, so that groups are contiguous)
+    std::vector<uint>  m_Candidates;
+    std::vector<Point> m_CandidatePts;
+
+    // Guess that succeeded and number of guesses made
+    uint               m_GroupSize;
+    uint               m_NbGuesses;
+
+    OutputSensitiveHull(const Point* i_Pts, uint i_NbPts);
+
+    // Returns false if all points are coplanar
+    bool compute();
+
+    // Returns false if the hull has more than i_GroupSize vertices, or if the
+    // points found are coplanar
+    bool wrap(uint i_GroupSize);
+
+    // Hull of every candidate by the triangle mesh engine
+    bool computeDirectly();
+
+    // Candidates in octree cells, in Morton order
+    void sortCandidates();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,163 @@
+#ifndef __Parallel__
+#define __Parallel__
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef unsigned int uint;
+
+// Number of threads used by parallel passes (defaults to the number of cores)
+inline uint& nbThreads()
+{
+    static uint s_NbThreads((std::max)(1u, std::thread::hardware_concurrency()));
+    return s_NbThreads;
+}
+
+// Restores the number of threads when it goes out of scope
+struct ThreadCountScope
+{
+    uint m_NbThreads;
+
+    ThreadCountScope() : m_NbThreads(nbThreads()) {}
+    ~ThreadCountScope() { nbThreads() = m_NbThreads; }
+};
+
+// Threads waiting for the chunks of parallelFor, so that short passes (one
+// insertion of the conflict graph engine) don't pay for creating threads.
+// Workers are created on demand and joined at exit.
+class WorkerPool
+{
+public:
+    WorkerPool() : m_IsBusy(false), m_IsStopping(false), m_Generation(0), m_Task(NULL), m_NbTasks(0), m_NbPending(0) {}
+
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_IsStopping = true;
+        }
+        m_WakeUp.notify_all();
+        for (std::thread& worker : m_Workers) {
+            worker.join();
+        }
+    }
+
+    // Calls i_Task(0) on the calling thread and i_Task(1) to
+    // i_Task(i_NbTasks - 1) on workers, and returns once they are all done.
+    // Returns false without running anything if the pool is already in use
+    // (another thread, or a task calling parallelFor).
+    bool run(uint i_NbTasks, const std::function<void(uint)>& i_Task)
+    {
+        if (m_IsBusy.exchange(true)) {
+            return false;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            while (m_Workers.size() + 1 < i_NbTasks) {
+                m_Workers.emplace_back(&WorkerPool::work, this, uint(m_Workers.size() + 1));
+            }
+            m_Task = &i_Task;
+            m_NbTasks = i_NbTasks;
+            m_NbPending = i_NbTasks - 1;
+            ++m_Generation;
+        }
+        m_WakeUp.notify_all();
+
+        i_Task(0);
+
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Done.wait(lock, [this]() { return m_NbPending == 0; });
+            m_Task = NULL;
+        }
+        m_IsBusy = false;
+        return true;
+    }
+
+private:
+    void work(uint i_TaskID)
+    {
+        unsigned long long generation(0);
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        while (true) {
+            m_WakeUp.wait(lock, [&]() { return m_IsStopping || m_Generation != generation; });
+            if (m_IsStopping) {
+                return;
+            }
+            generation = m_Generation;
+            if (i_TaskID >= m_NbTasks) {
+                continue;
+            }
+
+            const std::function<void(uint)>& task(*m_Task);
+            lock.unlock();
+            task(i_TaskID);
+            lock.lock();
+            if (--m_NbPending == 0) {
+                m_Done.notify_one();
+            }
+        }
+    }
+
+    std::atomic<bool>                  m_IsBusy;
+    std::mutex                         m_Mutex;
+    std::condition_variable            m_WakeUp;
+    std::condition_variable            m_Done;
+    std::vector<std::thread>           m_Workers;
+    bool                               m_IsStopping;
+    unsigned long long                 m_Generation;
+    const std::function<void(uint)>*   m_Task;
+    uint                               m_NbTasks;
+    uint                               m_NbPending;
+};
+
+inline WorkerPool& workerPool()
+{
+    static WorkerPool s_Pool;
+    return s_Pool;
+}
+
+// Splits [i_Begin, i_End) in one contiguous chunk per thread and calls
+// i_Func(threadID, chunkBegin, chunkEnd) for each chunk. The calling thread
+// processes the first chunk, workerPool() the others (or new threads when the
+// pool is in use, as in nested calls).
+template <typename Func>
+void parallelFor(uint i_Begin, uint i_End, Func i_Func)
+{
+    uint nbItems(i_End > i_Begin ? i_End - i_Begin : 0);
+    uint nbChunks((std::max)(1u, (std::min)(nbThreads(), nbItems)));
+    uint chunkSize((nbItems + nbChunks - 1) / (std::max)(1u, nbChunks));
+
+    // Not worth waking threads
+    if (nbChunks == 1) {
+        i_Func(0, i_Begin, i_End);
+        return;
+    }
+
+    std::function<void(uint)> chunk([&](uint i_Chunk) {
+        uint begin((std::min)(i_End, i_Begin + i_Chunk * chunkSize));
+        uint end((std::min)(i_End, begin + chunkSize));
+        i_Func(i_Chunk, begin, end);
+    });
+    if (workerPool().run(nbChunks, chunk)) {
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    for (uint t = 1; t < nbChunks; ++t) {
+        threads.emplace_back(chunk, t);
+    }
+    chunk(0);
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+#endif
\ No newline at end of file
@@ -8,34 +8,40 @@
 
 #include "Point.h"
 
-Point::Point()
+template <typename Scalar>
+TPoint<Scalar>::TPoint()
 :   m_x(0.0f),
     m_y(0.0f),
     m_z(0.0f)
 {}
 
-Point::Point(const double a_k)
+template <typename Scalar>
+TPoint<Scalar>::TPoint(const Scalar a_k)
 :   m_x(a_k),
     m_y(a_k),
     m_z(a_k)
 {}
 
-Point::Point(double a_x, double a_y, double a_z)
+template <typename Scalar>
+TPoint<Scalar>::TPoint(Scalar a_x, Scalar a_y, Scalar a_z)
 :   m_x(a_x),
     m_y(a_y),
     m_z(a_z)
 {}
 
-Point::Point(const Point& a_p)
+template <typename Scalar>
+TPoint<Scalar>::TPoint(const TPoint& a_p)
 :   m_x(a_p.m_x),
     m_y(a_p.m_y),
     m_z(a_p.m_z)
 {}
 
-Point::~Point()
+template <typename Scalar>
+TPoint<Scalar>::~TPoint()
 {}
 
-Point& Point::operator=(const Point& a_p)
+template <typename Scalar>
+TPoint<Scalar>& TPoint<Scalar>::operator=(const TPoint& a_p)
 {
     if (this == &a_p)
     {
@@ -49,7 +55,6 @@ Point& Point::operator=(const Point& a_p)
     return *this;
 }
 
-double distance(const Point& a_p1, const Point& a_p2)
-{
-    return (a_p1 - a_p2).norm();
-}
\ No newline at end of file
+template class TPoint<int>;
+template class TPoint<float>;
+template class TPoint<double>;
\ No newline at end of file
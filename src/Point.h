@@ -5,59 +5,76 @@
 
 #include "Vector.h"
 
-class Point {
+template <typename Scalar>
+class TPoint {
     
 public:
         
-    Point();
-    Point(const double a_k);
-    Point(double a_x, double a_y, double a_z);
-    Point(const Point& a_p);
+    TPoint();
+    TPoint(const Scalar a_k);
+    TPoint(Scalar a_x, Scalar a_y, Scalar a_z);
+    TPoint(const TPoint& a_p);
+    template <typename Other>
+    explicit TPoint(const TPoint<Other>& a_p);
     
-    ~Point();
+    ~TPoint();
     
-    Point& operator=(const Point& a_p);
-    Point operator-() const;
-    Vector operator-(const Point& a_p) const;
-    Point operator+(const Vector& a_v) const;
-    Point operator-(const Vector& a_v) const;
-    Point& operator+=(const Vector& a_v);
-    Point& operator-=(const Vector& a_v);
-    Point operator*(double a_k) const;
-    Point operator/(double a_k) const;
-    Point& operator*=(double a_k);
-    Point& operator/=(double a_k);
-    double operator[](int a_i) const;
-    double& operator[](int a_i);
-    
-    friend double distance(const Point& a_p1, const Point& a_p2);
+    TPoint& operator=(const TPoint& a_p);
+    TPoint operator-() const;
+    TVector<Scalar> operator-(const TPoint& a_p) const;
+    TPoint operator+(const TVector<Scalar>& a_v) const;
+    TPoint operator-(const TVector<Scalar>& a_v) const;
+    TPoint& operator+=(const TVector<Scalar>& a_v);
+    TPoint& operator-=(const TVector<Scalar>& a_v);
+    TPoint operator*(Scalar a_k) const;
+    TPoint operator/(Scalar a_k) const;
+    TPoint& operator*=(Scalar a_k);
+    TPoint& operator/=(Scalar a_k);
+    Scalar operator[](int a_i) const;
+    Scalar& operator[](int a_i);
         
-    double m_x;
-    double m_y;
-    double m_z;
+    Scalar m_x;
+    Scalar m_y;
+    Scalar m_z;
 };
 
-inline Point Point::operator-() const
+typedef TPoint<double> Point;
+typedef TPoint<float>  PointF;
+
+template <typename Scalar>
+template <typename Other>
+inline TPoint<Scalar>::TPoint(const TPoint<Other>& a_p)
+:   m_x(Scalar(a_p.m_x)),
+    m_y(Scalar(a_p.m_y)),
+    m_z(Scalar(a_p.m_z))
+{}
+
+template <typename Scalar>
+inline TPoint<Scalar> TPoint<Scalar>::operator-() const
 {
-    return Point(-m_x, -m_y, -m_z);
+    return TPoint(-m_x, -m_y, -m_z);
 }
 
-inline Vector Point::operator-(const Point& a_p) const
+template <typename Scalar>
+inline TVector<Scalar> TPoint<Scalar>::operator-(const TPoint& a_p) const
 {
-    return Vector(m_x - a_p.m_x, m_y - a_p.m_y, m_z - a_p.m_z);
+    return TVector<Scalar>(m_x - a_p.m_x, m_y - a_p.m_y, m_z - a_p.m_z);
 }
 
-inline Point Point::operator+(const Vector& a_v) const
+template <typename Scalar>
+inline TPoint<Scalar> TPoint<Scalar>::operator+(const TVector<Scalar>& a_v) const
 {
-    return Point(m_x + a_v.m_x, m_y + a_v.m_y, m_z + a_v.m_z);
+    return TPoint(m_x + a_v.m_x, m_y + a_v.m_y, m_z + a_v.m_z);
 }
 
-inline Point Point::operator-(const Vector& a_v) const
+template <typename Scalar>
+inline TPoint<Scalar> TPoint<Scalar>::operator-(const TVector<Scalar>& a_v) const
 {
-    return Point(m_x - a_v.m_x, m_y - a_v.m_y, m_z - a_v.m_z);
+    return TPoint(m_x - a_v.m_x, m_y - a_v.m_y, m_z - a_v.m_z);
 }
 
-inline Point& Point::operator+=(const Vector& a_v)
+template <typename Scalar>
+inline TPoint<Scalar>& TPoint<Scalar>::operator+=(const TVector<Scalar>& a_v)
 {
     m_x += a_v.m_x;
     m_y += a_v.m_y;
@@ -66,7 +83,8 @@ inline Point& Point::operator+=(const Vector& a_v)
     return *this;
 }
 
-inline Point& Point::operator-=(const Vector& a_v)
+template <typename Scalar>
+inline TPoint<Scalar>& TPoint<Scalar>::operator-=(const TVector<Scalar>& a_v)
 {
     m_x -= a_v.m_x;
     m_y -= a_v.m_y;
@@ -75,21 +93,24 @@ inline Point& Point::operator-=(const Vector& a_v)
     return *this;
 }
 
-inline Point Point::operator*(double a_k) const
+template <typename Scalar>
+inline TPoint<Scalar> TPoint<Scalar>::operator*(Scalar a_k) const
 {
-    return Point(a_k * m_x, a_k * m_y, a_k * m_z);
+    return TPoint(a_k * m_x, a_k * m_y, a_k * m_z);
 }
 
-inline Point Point::operator/(double a_k) const
+template <typename Scalar>
+inline TPoint<Scalar> TPoint<Scalar>::operator/(Scalar a_k) const
 {
     assert(a_k != 0.0f);
     
-	float inv = (float)(1.0f / a_k);
+    Scalar inv = Scalar(1) / a_k;
     
-    return Point(m_x * inv, m_y * inv, m_z * inv);
+    return TPoint(m_x * inv, m_y * inv, m_z * inv);
 }
 
-inline Point& Point::operator*=(double a_k)
+template <typename Scalar>
+inline TPoint<Scalar>& TPoint<Scalar>::operator*=(Scalar a_k)
 {
     m_x *= a_k;
     m_y *= a_k;
@@ -98,11 +119,12 @@ inline Point& Point::operator*=(double a_k)
     return *this;
 }
 
-inline Point& Point::operator/=(double a_k)
+template <typename Scalar>
+inline TPoint<Scalar>& TPoint<Scalar>::operator/=(Scalar a_k)
 {
     assert(a_k != 0.0f);
     
-	float inv = (float)(1.0f / a_k);
+    Scalar inv = Scalar(1) / a_k;
     
     m_x *= inv;
     m_y *= inv;
@@ -111,21 +133,30 @@ inline Point& Point::operator/=(double a_k)
     return *this;
 }
 
-inline double Point::operator[](int a_i) const
+template <typename Scalar>
+inline Scalar TPoint<Scalar>::operator[](int a_i) const
 {
     assert(a_i >= 0 && a_i <= 2);
     
     return (&m_x)[a_i];
 }
 
-inline double& Point::operator[](int a_i)
+template <typename Scalar>
+inline Scalar& TPoint<Scalar>::operator[](int a_i)
 {
     assert(a_i >= 0 && a_i <= 2);
     
     return (&m_x)[a_i];
 }
 
-inline double squareDistance(const Point& a_p1, const Point& a_p2)
+template <typename Scalar>
+inline Scalar distance(const TPoint<Scalar>& a_p1, const TPoint<Scalar>& a_p2)
+{
+    return (a_p1 - a_p2).norm();
+}
+
+template <typename Scalar>
+inline Scalar squareDistance(const TPoint<Scalar>& a_p1, const TPoint<Scalar>& a_p2)
 {
     return (a_p1 - a_p2).squareNorm();
 }
@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <limits>
+
+#include "Parallel.h"
+#include "SpaceFillingCurve.h"
+
+// Inserts two zeros between each of the 21 lowest bits
+static unsigned long long spreadBits(unsigned long long i_Bits)
+{
+    i_Bits &= 0x1fffff;
+    i_Bits = (i_Bits | i_Bits << 32) & 0x1f00000000ffffULL;
+    i_Bits = (i_Bits | i_Bits << 16) & 0x1f0000ff0000ffULL;
+    i_Bits = (i_Bits | i_Bits << 8)  & 0x100f00f00f00f00fULL;
+    i_Bits = (i_Bits | i_Bits << 4)  & 0x10c30c30c30c30c3ULL;
+    i_Bits = (i_Bits | i_Bits << 2)  & 0x1249249249249249ULL;
+    return i_Bits;
+}
+
+template <typename PointOf>
+static std::vector<unsigned long long> computeCodes(uint i_NbPts, PointOf i_PointOf)
+{
+    // Compute the bounding box (one per thread, then merged)
+    std::vector<Point> mins(nbThreads(), Point(std::numeric_limits<double>::max()));
+    std::vector<Point> maxs(nbThreads(), Point(-std::numeric_limits<double>::max()));
+    parallelFor(0, i_NbPts, [&](uint i_Thread, uint i_Begin, uint i_End) {
+        for (uint i = i_Begin; i < i_End; ++i) {
+            for (int axis = 0; axis < 3; ++axis) {
+                mins[i_Thread][axis] = (std::min)(mins[i_Thread][axis], i_PointOf(i)[axis]);
+                maxs[i_Thread][axis] = (std::max)(maxs[i_Thread][axis], i_PointOf(i)[axis]);
+            }
+        }
+    });
+    for (uint t = 1; t < mins.size(); ++t) {
+        for (int axis = 0; axis < 3; ++axis) {
+            mins[0][axis] = (std::min)(mins[0][axis], mins[t][axis]);
+            maxs[0][axis] = (std::max)(maxs[0][axis], maxs[t][axis]);
+        }
+    }
+
+    // Scale factor from the bounding box to the grid
+    double scale[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        double extent(maxs[0][axis] - mins[0][axis]);
+        scale[axis] = extent > 0 ? double(0x1fffff) / extent : 0;
+    }
+
+    // Interleave quantized coordinates
+    std::vector<unsigned long long> codes(i_NbPts);
+    parallelFor(0, i_NbPts, [&](uint, uint i_Begin, uint i_End) {
+        for (uint i = i_Begin; i < i_End; ++i) {
+            unsigned long long code(0);
+            for (int axis = 0; axis < 3; ++axis) {
+                double cell((i_PointOf(i)[axis] - mins[0][axis]) * scale[axis]);
+                code |= spreadBits((unsigned long long)cell) << axis;
+            }
+            codes[i] = code;
+        }
+    });
+
+    return codes;
+}
+
+std::vector<unsigned long long> computeMortonCodes(const std::vector<sPoint>& i_Pts)
+{
+    return computeCodes(i_Pts.size(), [&](uint i_Pt) -> const Point& { return *i_Pts[i_Pt]; });
+}
+
+std::vector<unsigned long long> computeMortonCodes(const Point* i_Pts, uint i_NbPts)
+{
+    return computeCodes(i_NbPts, [&](uint i_Pt) -> const Point& { return i_Pts[i_Pt]; });
+}
\ No newline at end of file
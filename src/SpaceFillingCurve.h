@@ -0,0 +1,13 @@
+#ifndef __SpaceFillingCurve__
+#define __SpaceFillingCurve__
+
+#include <vector>
+
+#include "DCEL3D.h"
+
+// Computes the 63-bit Morton (Z-order) code of each point, after quantizing
+// its coordinates on a 2^21 grid spanning the bounding box. Runs in parallel.
+std::vector<unsigned long long> computeMortonCodes(const std::vector<sPoint>& i_Pts);
+std::vector<unsigned long long> computeMortonCodes(const Point* i_Pts, uint i_NbPts);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef __TriangleMesh__
+#define __TriangleMesh__
+
+#include <vector>
+
+typedef unsigned int uint;
+
+#define NO_TWIN uint(-1)
+
+// Triangle mesh with implicit half-edges: half-edge 3f+i is the i-th edge of
+// facet f, so next, previous and facet are computed from its index and only
+// the origin vertex and twin are stored (8 bytes per half-edge).
+struct TriangleMesh
+{
+    std::vector<uint> m_Origins;
+    std::vector<uint> m_Twins;
+
+    static uint facetOf(uint i_HalfEdge) { return i_HalfEdge / 3; }
+    static uint next(uint i_HalfEdge) { return i_HalfEdge % 3 == 2 ? i_HalfEdge - 2 : i_HalfEdge + 1; }
+    static uint prev(uint i_HalfEdge) { return i_HalfEdge % 3 == 0 ? i_HalfEdge + 2 : i_HalfEdge - 1; }
+
+    uint nbFacets() const { return m_Origins.size() / 3; }
+
+    // Vertex at the end of the half-edge
+    uint target(uint i_HalfEdge) const { return m_Origins[next(i_HalfEdge)]; }
+
+    void twin(uint i_HalfEdgeA, uint i_HalfEdgeB)
+    {
+        m_Twins[i_HalfEdgeA] = i_HalfEdgeB;
+        m_Twins[i_HalfEdgeB] = i_HalfEdgeA;
+    }
+};
+
+#endif
\ No newline at end of file
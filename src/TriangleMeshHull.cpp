@@ -0,0 +1,421 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "TriangleMeshHull.h"
+
+template <typename Scalar>
+TTriangleMeshHull<Scalar>::TTriangleMeshHull(const TPoint<Scalar>* i_Pts, uint i_NbPts, bool i_TrackMembership) :
+    m_Pts(i_Pts),
+    m_NbPts(i_NbPts),
+    m_Mesh(),
+    m_Normals(),
+    m_Offsets(),
+    m_Tolerance(),
+    m_TrackMembership(i_TrackMembership),
+    m_Membership(),
+    m_IsAlive(),
+    m_Epochs(),
+    m_Conflicts(),
+    m_PtsOnFacet(),
+    m_ConflictOfPt(),
+    m_FreeFacets(),
+    m_Epoch(0){}
+
+// Flatness of the initial tetrahedron: relative to the size of the input
+// (i_IsThin) or exact
+template <typename Scalar>
+static bool isFlat(const TPoint<Scalar>& i_A, const TPoint<Scalar>& i_B, const TPoint<Scalar>& i_C,
+                   const TPoint<Scalar>& i_D, bool i_IsThin)
+{
+    return i_IsThin || GeometryTraits<Scalar>::computeOrientation(i_A, i_B, i_C, i_D) == 0;
+}
+
+static bool isFlat(const TPoint<int>& i_A, const TPoint<int>& i_B, const TPoint<int>& i_C,
+                   const TPoint<int>& i_D, bool)
+{
+    return areCollinear(i_A, i_B, i_C) || areCoplanar(i_A, i_B, i_C, i_D);
+}
+
+template <typename Scalar>
+void TTriangleMeshHull<Scalar>::computeTolerance()
+{
+    if (m_NbPts == 0) {
+        return;
+    }
+    Point min(m_Pts[0]), max(m_Pts[0]);
+    for (uint i = 1; i < m_NbPts; ++i) {
+        Point pt(m_Pts[i]);
+        for (int axis = 0; axis < 3; ++axis) {
+            min[axis] = (std::min)(min[axis], pt[axis]);
+            max[axis] = (std::max)(max[axis], pt[axis]);
+        }
+    }
+    m_Tolerance = Traits::computeTolerance(min, max);
+}
+
+template <typename Scalar>
+int TTriangleMeshHull<Scalar>::exactSide(uint i_Facet, const TPoint<Scalar>& i_Pt) const
+{
+    const uint* vertices(&m_Mesh.m_Origins[3 * i_Facet]);
+    return Traits::computeOrientation(m_Pts[vertices[0]], m_Pts[vertices[1]], m_Pts[vertices[2]], i_Pt);
+}
+
+template <typename Scalar>
+bool TTriangleMeshHull<Scalar>::findInitialTetrahedron(uint o_Vertices[4]) const
+{
+    if (m_NbPts < 4) {
+        return false;
+    }
+
+    // Points with min and max x
+    uint minX(0), maxX(0);
+    for (uint i = 1; i < m_NbPts; ++i) {
+        if (m_Pts[i].m_x < m_Pts[minX].m_x) minX = i;
+        if (m_Pts[i].m_x > m_Pts[maxX].m_x) maxX = i;
+    }
+
+    // Point farthest from the line
+    Point origin(m_Pts[minX]);
+    Vector dir(Point(m_Pts[maxX]) - origin);
+    uint farFromLine(0);
+    double maxDist(0);
+    for (uint i = 0; i < m_NbPts; ++i) {
+        double dist(cross(dir, Point(m_Pts[i]) - origin).squareNorm());
+        if (dist > maxDist) {
+            maxDist = dist;
+            farFromLine = i;
+        }
+    }
+
+    // Point farthest from the plane
+    Vector normal(cross(dir, Point(m_Pts[farFromLine]) - origin));
+    uint farFromPlane(0);
+    maxDist = 0;
+    for (uint i = 0; i < m_NbPts; ++i) {
+        double dist(fabs(dot(normal, Point(m_Pts[i]) - origin)));
+        if (dist > maxDist) {
+            maxDist = dist;
+            farFromPlane = i;
+        }
+    }
+
+    // Give up if the tetrahedron is flat
+    double scale(dir.squareNorm());
+    bool isThin(scale == 0 || maxDist <= 1e-12 * scale * sqrt(scale));
+    if (isFlat(m_Pts[minX], m_Pts[maxX], m_Pts[farFromLine], m_Pts[farFromPlane], isThin)) {
+        return false;
+    }
+
+    o_Vertices[0] = minX;
+    o_Vertices[1] = maxX;
+    o_Vertices[2] = farFromLine;
+    o_Vertices[3] = farFromPlane;
+    return true;
+}
+
+template <typename Scalar>
+uint TTriangleMeshHull<Scalar>::addFacet(uint i_A, uint i_B, uint i_C)
+{
+    // Reuse the slot of a deleted facet if there is one
+    uint facet;
+    if (!m_FreeFacets.empty()) {
+        facet = m_FreeFacets.back();
+        m_FreeFacets.pop_back();
+    } else {
+        facet = m_Mesh.nbFacets();
+        m_Mesh.m_Origins.resize(3 * (facet + 1));
+        m_Mesh.m_Twins.resize(3 * (facet + 1), NO_TWIN);
+        m_Normals.resize(facet + 1);
+        m_Offsets.resize(facet + 1);
+        m_IsAlive.resize(facet + 1);
+        m_Epochs.resize(facet + 1, 0);
+        m_Conflicts.resize(facet + 1);
+        m_PtsOnFacet.resize(facet + 1);
+    }
+
+    m_Mesh.m_Origins[3 * facet]     = i_A;
+    m_Mesh.m_Origins[3 * facet + 1] = i_B;
+    m_Mesh.m_Origins[3 * facet + 2] = i_C;
+    m_Normals[facet] = Traits::computeNormal(m_Pts[i_A], m_Pts[i_B], m_Pts[i_C]);
+    m_Offsets[facet] = Traits::computeOffset(m_Normals[facet], m_Pts[i_A]);
+    m_IsAlive[facet] = true;
+    m_Conflicts[facet].clear();
+    m_PtsOnFacet[facet].clear();
+
+    return facet;
+}
+
+template <typename Scalar>
+bool TTriangleMeshHull<Scalar>::placeInsidePoint(uint i_PtIdx, const std::vector<uint>& i_Facets)
+{
+    // A point inside the hull that lies on the plane of a facet is on the
+    // boundary
+    for (uint facet : i_Facets) {
+        if (isOnPlane(facet, m_Pts[i_PtIdx])) {
+            m_Membership[i_PtIdx] = ON_HULL_FACET;
+            m_PtsOnFacet[facet].push_back(i_PtIdx);
+            return true;
+        }
+    }
+    m_Membership[i_PtIdx] = INTERIOR_POINT;
+    return false;
+}
+
+template <typename Scalar>
+void TTriangleMeshHull<Scalar>::placeRemovedPoints(uint i_Facet, const std::vector<uint>& i_NewFacets,
+                                                   const std::vector<uint>& i_HorizonFacets,
+                                                   const std::vector<uint>& i_HorizonVertices)
+{
+    // Points on the deleted facet can stay on the boundary through a new facet
+    // or a facet across the horizon
+    for (uint ptIdx : m_PtsOnFacet[i_Facet]) {
+        if (!placeInsidePoint(ptIdx, i_NewFacets)) {
+            placeInsidePoint(ptIdx, i_HorizonFacets);
+        }
+    }
+
+    // Its vertices that are not on the horizon are removed
+    for (uint halfEdge = 3 * i_Facet; halfEdge < 3 * i_Facet + 3; ++halfEdge) {
+        uint vertex(m_Mesh.m_Origins[halfEdge]);
+        if (m_Membership[vertex] == HULL_VERTEX &&
+            !std::binary_search(i_HorizonVertices.begin(), i_HorizonVertices.end(), vertex)) {
+            placeInsidePoint(vertex, i_NewFacets);
+        }
+    }
+}
+
+template <typename Scalar>
+void TTriangleMeshHull<Scalar>::assignConflict(uint i_PtIdx, const std::vector<uint>& i_NewFacets,
+                                               const std::vector<uint>& i_HorizonFacets)
+{
+    const TPoint<Scalar>& pt(m_Pts[i_PtIdx]);
+    m_ConflictOfPt[i_PtIdx] = NO_FACET;
+
+    // If the point is still outside, it sees a new facet or a facet just
+    // outside the horizon
+    for (uint facet : i_NewFacets) {
+        if (isVisible(facet, pt)) {
+            m_ConflictOfPt[i_PtIdx] = facet;
+            m_Conflicts[facet].push_back(i_PtIdx);
+            return;
+        }
+    }
+    for (uint facet : i_HorizonFacets) {
+        if (isVisible(facet, pt)) {
+            m_ConflictOfPt[i_PtIdx] = facet;
+            m_Conflicts[facet].push_back(i_PtIdx);
+            return;
+        }
+    }
+
+    // Otherwise it is inside, and only new facets can have it on their boundary
+    if (m_TrackMembership) {
+        placeInsidePoint(i_PtIdx, i_NewFacets);
+    }
+}
+
+template <typename Scalar>
+void TTriangleMeshHull<Scalar>::insertPoint(uint i_PtIdx)
+{
+    const TPoint<Scalar>& pt(m_Pts[i_PtIdx]);
+
+    // Find visible facets with a BFS from the known one
+    ++m_Epoch;
+    std::vector<uint> visible(1, m_ConflictOfPt[i_PtIdx]);
+    m_Epochs[visible[0]] = m_Epoch;
+    for (uint i = 0; i < visible.size(); ++i) {
+        for (uint halfEdge = 3 * visible[i]; halfEdge < 3 * visible[i] + 3; ++halfEdge) {
+            uint neighbor(TriangleMesh::facetOf(m_Mesh.m_Twins[halfEdge]));
+            if (m_Epochs[neighbor] != m_Epoch && isReplacedBy(neighbor, pt)) {
+                m_Epochs[neighbor] = m_Epoch;
+                visible.push_back(neighbor);
+            }
+        }
+    }
+
+    // Find a half-edge on the horizon
+    uint start(NO_TWIN);
+    for (uint i = 0; i < visible.size() && start == NO_TWIN; ++i) {
+        for (uint halfEdge = 3 * visible[i]; halfEdge < 3 * visible[i] + 3; ++halfEdge) {
+            if (m_Epochs[TriangleMesh::facetOf(m_Mesh.m_Twins[halfEdge])] != m_Epoch) {
+                start = halfEdge;
+                break;
+            }
+        }
+    }
+
+    // Walk along the horizon (turning around the end of each horizon half-edge
+    // until the next one is found)
+    std::vector<uint> horizon;
+    uint halfEdge(start);
+    do {
+        horizon.push_back(halfEdge);
+        halfEdge = TriangleMesh::next(halfEdge);
+        while (m_Epochs[TriangleMesh::facetOf(m_Mesh.m_Twins[halfEdge])] == m_Epoch) {
+            halfEdge = TriangleMesh::next(m_Mesh.m_Twins[halfEdge]);
+        }
+    } while (halfEdge != start);
+
+    // Build the cone of new facets. Edge 0 of each new facet is on the horizon,
+    // edge 1 goes to the new point and edge 2 comes back from it.
+    std::vector<uint> newFacets;
+    for (uint edge : horizon) {
+        uint twin(m_Mesh.m_Twins[edge]);
+        uint facet(addFacet(m_Mesh.m_Origins[edge], m_Mesh.target(edge), i_PtIdx));
+        m_Mesh.twin(3 * facet, twin);
+        if (!newFacets.empty()) {
+            m_Mesh.twin(3 * facet + 2, 3 * newFacets.back() + 1);
+        }
+        newFacets.push_back(facet);
+    }
+    m_Mesh.twin(3 * newFacets.front() + 2, 3 * newFacets.back() + 1);
+
+    // Facets just outside the horizon (visible facets still know their twins)
+    std::vector<uint> horizonFacets;
+    for (uint edge : horizon) {
+        horizonFacets.push_back(TriangleMesh::facetOf(m_Mesh.m_Twins[edge]));
+    }
+
+    std::vector<uint> horizonVertices;
+    if (m_TrackMembership) {
+        for (uint edge : horizon) {
+            horizonVertices.push_back(m_Mesh.m_Origins[edge]);
+        }
+        std::sort(horizonVertices.begin(), horizonVertices.end());
+        m_Membership[i_PtIdx] = HULL_VERTEX;
+    }
+
+    // Give points that saw deleted facets a new conflict, then delete them
+    for (uint facet : visible) {
+        for (uint ptIdx : m_Conflicts[facet]) {
+            if (ptIdx != i_PtIdx) {
+                assignConflict(ptIdx, newFacets, horizonFacets);
+            }
+        }
+        if (m_TrackMembership) {
+            placeRemovedPoints(facet, newFacets, horizonFacets, horizonVertices);
+        }
+        m_IsAlive[facet] = false;
+        std::vector<uint>().swap(m_Conflicts[facet]);
+        std::vector<uint>().swap(m_PtsOnFacet[facet]);
+        m_FreeFacets.push_back(facet);
+    }
+}
+
+template <typename Scalar>
+bool TTriangleMeshHull<Scalar>::compute()
+{
+    // Build initial tetrahedron, with facets facing away from the fourth point
+    computeTolerance();
+    uint tetra[4];
+    if (!findInitialTetrahedron(tetra)) {
+        return false;
+    }
+    const uint faces[4][4] = { { 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 1, 3, 2, 0 }, { 2, 3, 0, 1 } };
+    for (const uint* face : faces) {
+        uint a(tetra[face[0]]), b(tetra[face[1]]), c(tetra[face[2]]);
+        if (Traits::computeOrientation(m_Pts[a], m_Pts[b], m_Pts[c], m_Pts[tetra[face[3]]]) > 0) {
+            std::swap(b, c);
+        }
+        addFacet(a, b, c);
+    }
+
+    // Twin half-edges of the tetrahedron going in opposite directions
+    for (uint i = 0; i < 12; ++i) {
+        for (uint j = i + 1; j < 12; ++j) {
+            if (m_Mesh.m_Origins[i] == m_Mesh.target(j) && m_Mesh.target(i) == m_Mesh.m_Origins[j]) {
+                m_Mesh.twin(i, j);
+            }
+        }
+    }
+
+    // Random insertion order of the other points
+    std::vector<uint> order;
+    for (uint i = 0; i < m_NbPts; ++i) {
+        if (i != tetra[0] && i != tetra[1] && i != tetra[2] && i != tetra[3]) {
+            order.push_back(i);
+        }
+    }
+    std::random_device rd;
+    std::mt19937 rng(rd());
+    std::shuffle(order.begin(), order.end(), rng);
+
+    // Initial conflicts
+    m_ConflictOfPt.assign(m_NbPts, NO_FACET);
+    for (uint ptIdx : order) {
+        for (uint facet = 0; facet < 4; ++facet) {
+            if (isVisible(facet, m_Pts[ptIdx])) {
+                m_ConflictOfPt[ptIdx] = facet;
+                m_Conflicts[facet].push_back(ptIdx);
+                break;
+            }
+        }
+    }
+    if (m_TrackMembership) {
+        const std::vector<uint> tetraFacets = { 0, 1, 2, 3 };
+        m_Membership.assign(m_NbPts, INTERIOR_POINT);
+        for (uint vertex : tetra) {
+            m_Membership[vertex] = HULL_VERTEX;
+        }
+        for (uint ptIdx : order) {
+            if (m_ConflictOfPt[ptIdx] == NO_FACET) {
+                placeInsidePoint(ptIdx, tetraFacets);
+            }
+        }
+    }
+
+    // Add each point outside the hull
+    for (uint ptIdx : order) {
+        if (m_ConflictOfPt[ptIdx] != NO_FACET) {
+            insertPoint(ptIdx);
+        }
+    }
+
+    compact();
+    return true;
+}
+
+template <typename Scalar>
+void TTriangleMeshHull<Scalar>::compact()
+{
+    // New index of each facet that is still alive
+    std::vector<uint> newIndex(m_Mesh.nbFacets(), NO_FACET);
+    uint nbFacets(0);
+    for (uint facet = 0; facet < m_Mesh.nbFacets(); ++facet) {
+        if (m_IsAlive[facet]) {
+            newIndex[facet] = nbFacets++;
+        }
+    }
+
+    // Move facets down
+    for (uint facet = 0; facet < m_Mesh.nbFacets(); ++facet) {
+        uint to(newIndex[facet]);
+        if (to == NO_FACET) {
+            continue;
+        }
+        for (uint i = 0; i < 3; ++i) {
+            uint twin(m_Mesh.m_Twins[3 * facet + i]);
+            m_Mesh.m_Origins[3 * to + i] = m_Mesh.m_Origins[3 * facet + i];
+            m_Mesh.m_Twins[3 * to + i] = 3 * newIndex[twin / 3] + twin % 3;
+        }
+        m_Normals[to] = m_Normals[facet];
+        m_Offsets[to] = m_Offsets[facet];
+    }
+    m_Mesh.m_Origins.resize(3 * nbFacets);
+    m_Mesh.m_Twins.resize(3 * nbFacets);
+    m_Normals.resize(nbFacets);
+    m_Offsets.resize(nbFacets);
+
+    // Release construction data
+    std::vector<char>().swap(m_IsAlive);
+    std::vector<uint>().swap(m_Epochs);
+    std::vector<std::vector<uint>>().swap(m_Conflicts);
+    std::vector<std::vector<uint>>().swap(m_PtsOnFacet);
+    std::vector<uint>().swap(m_ConflictOfPt);
+    std::vector<uint>().swap(m_FreeFacets);
+}
+
+template struct TTriangleMeshHull<int>;
+template struct TTriangleMeshHull<float>;
+template struct TTriangleMeshHull<double>;
\ No newline at end of file
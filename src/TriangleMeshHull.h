@@ -0,0 +1,113 @@
+#ifndef __TriangleMeshHull__
+#define __TriangleMeshHull__
+
+#include <vector>
+
+#include "GeometryTraits.h"
+#include "TriangleMesh.h"
+
+#define NO_FACET uint(-1)
+
+// Where an input point ended up, one byte per point
+enum PointMembership { INTERIOR_POINT, ON_HULL_FACET, HULL_VERTEX };
+
+// Randomized incremental convex hull built directly on a TriangleMesh. Every
+// pending point remembers a single facet it can see, and the visible region is
+// found by a BFS from that facet. Facets are never merged, so coplanar facets
+// are left for a post-pass. Hulls of different point sets can be computed in
+// parallel since there is no shared state. Templated on the coordinate type
+// (see GeometryTraits for how predicates are evaluated).
+template <typename Scalar>
+struct TTriangleMeshHull
+{
+    typedef GeometryTraits<Scalar>    Traits;
+    typedef typename Traits::Normal   Normal;
+    typedef typename Traits::Offset   Offset;
+
+    // Input (not owned)
+    const TPoint<Scalar>* m_Pts;
+    uint               m_NbPts;
+
+    // Hull (vertices are indices in the input)
+    TriangleMesh       m_Mesh;
+    std::vector<Normal> m_Normals;
+    std::vector<Offset> m_Offsets;
+
+    // Rounding error bound of the predicates for this input, below which
+    // they fall back to exact orientations (see GeometryTraits)
+    Offset             m_Tolerance;
+
+    // When tracked, one PointMembership per input point, kept up to date while
+    // inserting: inserted points are vertices until an insertion removes them,
+    // and points found inside are on a facet if they lie on the plane of a new
+    // one (that facet remembers them until it is deleted), interior otherwise
+    bool               m_TrackMembership;
+    std::vector<unsigned char> m_Membership;
+
+    // Construction data (released by compute())
+    std::vector<char>  m_IsAlive;
+    std::vector<uint>  m_Epochs;
+    std::vector<std::vector<uint>> m_Conflicts;
+    std::vector<std::vector<uint>> m_PtsOnFacet;     // Inside points on the facet plane
+    std::vector<uint>  m_ConflictOfPt;
+    std::vector<uint>  m_FreeFacets;
+    uint               m_Epoch;
+
+    TTriangleMeshHull(const TPoint<Scalar>* i_Pts, uint i_NbPts, bool i_TrackMembership = false);
+
+    // Returns false if all points are coplanar
+    bool compute();
+
+    // Exact sign of the offset of the point from the facet plane
+    int side(uint i_Facet, const TPoint<Scalar>& i_Pt) const
+    {
+        Offset offset(Traits::computeOffset(m_Normals[i_Facet], i_Pt) - m_Offsets[i_Facet]);
+        if (offset > m_Tolerance) {
+            return 1;
+        }
+        if (offset < -m_Tolerance) {
+            return -1;
+        }
+        return exactSide(i_Facet, i_Pt);
+    }
+
+    // Out of line, so that side() stays small enough to inline
+    int exactSide(uint i_Facet, const TPoint<Scalar>& i_Pt) const;
+
+    bool isVisible(uint i_Facet, const TPoint<Scalar>& i_Pt) const
+    {
+        return side(i_Facet, i_Pt) > 0;
+    }
+
+    // Facets the inserted point sees or lies on are all replaced, so that
+    // every new facet has the point strictly below its horizon neighbor and
+    // none of them is flat
+    bool isReplacedBy(uint i_Facet, const TPoint<Scalar>& i_Pt) const
+    {
+        return side(i_Facet, i_Pt) >= 0;
+    }
+
+    // Membership only: within the rounding tolerance of the facet plane
+    bool isOnPlane(uint i_Facet, const TPoint<Scalar>& i_Pt) const
+    {
+        return Traits::isOnPlane(m_Normals[i_Facet], m_Offsets[i_Facet], i_Pt, m_Tolerance);
+    }
+
+    void computeTolerance();
+
+    bool findInitialTetrahedron(uint o_Vertices[4]) const;
+    uint addFacet(uint i_A, uint i_B, uint i_C);
+    void assignConflict(uint i_PtIdx, const std::vector<uint>& i_NewFacets,
+                        const std::vector<uint>& i_HorizonFacets);
+    bool placeInsidePoint(uint i_PtIdx, const std::vector<uint>& i_Facets);
+    void placeRemovedPoints(uint i_Facet, const std::vector<uint>& i_NewFacets,
+                            const std::vector<uint>& i_HorizonFacets,
+                            const std::vector<uint>& i_HorizonVertices);
+    void insertPoint(uint i_PtIdx);
+    void compact();
+};
+
+typedef TTriangleMeshHull<double> TriangleMeshHull;
+typedef TTriangleMeshHull<float>  TriangleMeshHullF;
+
+#endif
\ No newline at end of file
@@ -8,40 +8,47 @@
 #include "Vector.h"
 #include "Point.h"
 
-Vector::Vector()
+template <typename Scalar>
+TVector<Scalar>::TVector()
 :   m_x(0.0f),
     m_y(0.0f),
     m_z(0.0f)
 {}
 
-Vector::Vector(double a_k)
+template <typename Scalar>
+TVector<Scalar>::TVector(Scalar a_k)
 :   m_x(a_k),
     m_y(a_k),
     m_z(a_k)
 {}
 
-Vector::Vector(double a_x, double a_y, double a_z)
+template <typename Scalar>
+TVector<Scalar>::TVector(Scalar a_x, Scalar a_y, Scalar a_z)
 :   m_x(a_x),
     m_y(a_y),
     m_z(a_z)
 {}
 
-Vector::Vector(const Vector& a_v)
+template <typename Scalar>
+TVector<Scalar>::TVector(const TVector& a_v)
 :   m_x(a_v.m_x),
     m_y(a_v.m_y),
     m_z(a_v.m_z)
 {}
 
-Vector::Vector(const Point& a_p)
+template <typename Scalar>
+TVector<Scalar>::TVector(const TPoint<Scalar>& a_p)
 :   m_x(a_p.m_x),
     m_y(a_p.m_y),
     m_z(a_p.m_z)
 {}
 
-Vector::~Vector()
+template <typename Scalar>
+TVector<Scalar>::~TVector()
 {}
 
-Vector& Vector::operator=(const Vector& a_v)
+template <typename Scalar>
+TVector<Scalar>& TVector<Scalar>::operator=(const TVector& a_v)
 {
     if (this == &a_v)
     {
@@ -55,7 +62,8 @@ Vector& Vector::operator=(const Vector& a_v)
     return (*this);
 }
 
-Vector& Vector::operator=(const Point& a_p)
+template <typename Scalar>
+TVector<Scalar>& TVector<Scalar>::operator=(const TPoint<Scalar>& a_p)
 {
     m_x = a_p.m_x;
     m_y = a_p.m_y;
@@ -64,14 +72,20 @@ Vector& Vector::operator=(const Point& a_p)
     return (*this);
 }
 
-double Vector::norm() const
+template <typename Scalar>
+Scalar TVector<Scalar>::norm() const
 {
     return sqrt(squareNorm());
 }
 
-Vector Vector::normalize() const
+template <typename Scalar>
+TVector<Scalar> TVector<Scalar>::normalize() const
 {
-    float inv = (float) (1.0f / norm());
+    Scalar inv = Scalar(1) / norm();
     
-    return Vector(m_x*inv, m_y*inv, m_z*inv);
-}
\ No newline at end of file
+    return TVector(m_x*inv, m_y*inv, m_z*inv);
+}
+
+template class TVector<int>;
+template class TVector<float>;
+template class TVector<double>;
\ No newline at end of file
@@ -5,63 +5,81 @@
 #include <assert.h>
 #include <cmath>
 
-class Point;
+template <typename Scalar> class TPoint;
 
-class Vector {
+template <typename Scalar>
+class TVector {
     
 public:
         
-    Vector();
-    Vector(double a_k);
-    Vector(double a_x, double a_y, double a_z);
-    Vector(const Vector& a_v);
-    Vector(const Point& a_p);
+    TVector();
+    TVector(Scalar a_k);
+    TVector(Scalar a_x, Scalar a_y, Scalar a_z);
+    TVector(const TVector& a_v);
+    TVector(const TPoint<Scalar>& a_p);
+    template <typename Other>
+    explicit TVector(const TVector<Other>& a_v);
     
-    ~Vector();
+    ~TVector();
     
-    Vector& operator=(const Vector& a_v);
-    Vector& operator=(const Point& a_p);
-    Vector operator-() const;
-    Vector operator*(double a_k) const;
-    Vector operator/(double a_k) const;
-    Vector& operator*=(double a_k);
-    Vector& operator/=(double a_k);
-    Vector operator+(const Vector& a_v) const;
-    Vector operator-(const Vector& a_v) const;
-    Vector& operator+=(const Vector& a_v);
-    Vector& operator-=(const Vector& a_v);
-    double operator[](int a_i) const;
-    double& operator[](int a_i);
+    TVector& operator=(const TVector& a_v);
+    TVector& operator=(const TPoint<Scalar>& a_p);
+    TVector operator-() const;
+    TVector operator*(Scalar a_k) const;
+    TVector operator/(Scalar a_k) const;
+    TVector& operator*=(Scalar a_k);
+    TVector& operator/=(Scalar a_k);
+    TVector operator+(const TVector& a_v) const;
+    TVector operator-(const TVector& a_v) const;
+    TVector& operator+=(const TVector& a_v);
+    TVector& operator-=(const TVector& a_v);
+    Scalar operator[](int a_i) const;
+    Scalar& operator[](int a_i);
     
-    double norm() const;
-    double squareNorm() const;
-    Vector normalize() const;
+    Scalar norm() const;
+    Scalar squareNorm() const;
+    TVector normalize() const;
         
-    double m_x;
-    double m_y;
-    double m_z;
+    Scalar m_x;
+    Scalar m_y;
+    Scalar m_z;
 };
 
-inline Vector Vector::operator-() const
+typedef TVector<double> Vector;
+typedef TVector<float>  VectorF;
+
+template <typename Scalar>
+template <typename Other>
+inline TVector<Scalar>::TVector(const TVector<Other>& a_v)
+:   m_x(Scalar(a_v.m_x)),
+    m_y(Scalar(a_v.m_y)),
+    m_z(Scalar(a_v.m_z))
+{}
+
+template <typename Scalar>
+inline TVector<Scalar> TVector<Scalar>::operator-() const
 {
-    return Vector(-m_x, -m_y, -m_z);
+    return TVector(-m_x, -m_y, -m_z);
 }
 
-inline Vector Vector::operator*(double a_k) const
+template <typename Scalar>
+inline TVector<Scalar> TVector<Scalar>::operator*(Scalar a_k) const
 {
-    return Vector(m_x * a_k, m_y * a_k, m_z * a_k);
+    return TVector(m_x * a_k, m_y * a_k, m_z * a_k);
 }
 
-inline Vector Vector::operator/(double a_k) const
+template <typename Scalar>
+inline TVector<Scalar> TVector<Scalar>::operator/(Scalar a_k) const
 {
     assert(a_k != 0.0f);
     
-    double inv = 1.0f / a_k;
+    Scalar inv = Scalar(1) / a_k;
     
-    return Vector(m_x * inv, m_y * inv, m_z * inv);
+    return TVector(m_x * inv, m_y * inv, m_z * inv);
 }
 
-inline Vector& Vector::operator*=(double a_k)
+template <typename Scalar>
+inline TVector<Scalar>& TVector<Scalar>::operator*=(Scalar a_k)
 {
     m_x *= a_k;
     m_y *= a_k;
@@ -70,11 +88,12 @@ inline Vector& Vector::operator*=(double a_k)
     return *this;
 }
 
-inline Vector& Vector::operator/=(double a_k)
+template <typename Scalar>
+inline TVector<Scalar>& TVector<Scalar>::operator/=(Scalar a_k)
 {
     assert(a_k != 0.0f);
     
-    double inv = 1.0f / a_k;
+    Scalar inv = Scalar(1) / a_k;
     
     m_x *= inv;
     m_y *= inv;
@@ -83,17 +102,20 @@ inline Vector& Vector::operator/=(double a_k)
     return *this;
 }
 
-inline Vector Vector::operator+(const Vector& a_v) const
+template <typename Scalar>
+inline TVector<Scalar> TVector<Scalar>::operator+(const TVector& a_v) const
 {
-    return Vector(m_x + a_v.m_x, m_y + a_v.m_y, m_z + a_v.m_z);
+    return TVector(m_x + a_v.m_x, m_y + a_v.m_y, m_z + a_v.m_z);
 }
 
-inline Vector Vector::operator-(const Vector& a_v) const
+template <typename Scalar>
+inline TVector<Scalar> TVector<Scalar>::operator-(const TVector& a_v) const
 {
-    return Vector(m_x - a_v.m_x, m_y - a_v.m_y, m_z - a_v.m_z);
+    return TVector(m_x - a_v.m_x, m_y - a_v.m_y, m_z - a_v.m_z);
 }
 
-inline Vector& Vector::operator+=(const Vector& a_v)
+template <typename Scalar>
+inline TVector<Scalar>& TVector<Scalar>::operator+=(const TVector& a_v)
 {
     m_x += a_v.m_x;
     m_y += a_v.m_y;
@@ -102,7 +124,8 @@ inline Vector& Vector::operator+=(const Vector& a_v)
     return *this;
 }
 
-inline Vector& Vector::operator-=(const Vector& a_v)
+template <typename Scalar>
+inline TVector<Scalar>& TVector<Scalar>::operator-=(const TVector& a_v)
 {
     m_x -= a_v.m_x;
     m_y -= a_v.m_y;
@@ -111,42 +134,55 @@ inline Vector& Vector::operator-=(const Vector& a_v)
     return *this;
 }
 
-inline double Vector::operator[](int a_i) const
+template <typename Scalar>
+inline Scalar TVector<Scalar>::operator[](int a_i) const
 {
     assert(a_i >= 0 && a_i <= 2);
     
     return (&m_x)[a_i];
 }
 
-inline double& Vector::operator[](int a_i)
+template <typename Scalar>
+inline Scalar& TVector<Scalar>::operator[](int a_i)
 {
     assert(a_i >= 0 && a_i <= 2);
     
     return (&m_x)[a_i];
 }
 
-inline double Vector::squareNorm() const
+template <typename Scalar>
+inline Scalar TVector<Scalar>::squareNorm() const
 {
     return m_x*m_x + m_y*m_y + m_z*m_z;
 }
 
 // Non-member Inline Functions
 
-inline double dot(const Vector& a_v1, const Vector& a_v2)
+template <typename Scalar>
+inline Scalar dot(const TVector<Scalar>& a_v1, const TVector<Scalar>& a_v2)
 {
     return a_v1.m_x * a_v2.m_x + a_v1.m_y * a_v2.m_y + a_v1.m_z * a_v2.m_z;
 }
 
-inline double absDot(const Vector& a_v1, const Vector& a_v2)
+// Dot product with the position vector of a point
+template <typename Scalar>
+inline Scalar dot(const TVector<Scalar>& a_v, const TPoint<Scalar>& a_p)
+{
+    return a_v.m_x * a_p.m_x + a_v.m_y * a_p.m_y + a_v.m_z * a_p.m_z;
+}
+
+template <typename Scalar>
+inline Scalar absDot(const TVector<Scalar>& a_v1, const TVector<Scalar>& a_v2)
 {
     return std::abs(dot(a_v1, a_v2));
 }
 
-inline Vector cross(const Vector& a_v1, const Vector& a_v2)
+template <typename Scalar>
+inline TVector<Scalar> cross(const TVector<Scalar>& a_v1, const TVector<Scalar>& a_v2)
 {
-    return Vector((a_v1.m_y * a_v2.m_z) - (a_v1.m_z * a_v2.m_y),
-                  (a_v1.m_z * a_v2.m_x) - (a_v1.m_x * a_v2.m_z),
-                  (a_v1.m_x * a_v2.m_y) - (a_v1.m_y * a_v2.m_x));
+    return TVector<Scalar>((a_v1.m_y * a_v2.m_z) - (a_v1.m_z * a_v2.m_y),
+                           (a_v1.m_z * a_v2.m_x) - (a_v1.m_x * a_v2.m_z),
+                           (a_v1.m_x * a_v2.m_y) - (a_v1.m_y * a_v2.m_x));
 }
 
 #endif
@@ -2,11 +2,19 @@
 /* PRESS 'm' TO TOGGLE BETWEEN VISUALIZATION MODES                      */
 /************************************************************************/
 
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
 #include <fstream>
+#include <string>
+#include <thread>
 #include <vector>
 #include <windows.h>
 
 #include "ConvexHull3D.h"
+#include "HullClassifier.h"
+#include "Mesh.h"
+#include "MeshWriter.h"
 #include "Point.h"
 #include "Vector.h"
 
@@ -14,6 +22,13 @@
 #include "GL/glu.h"
 #include "glut/glut.h"
 
+#ifndef _WIN32
+#include <GL/glx.h>
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+#endif
+
 #define GLUT_DISABLE_ATEXIT_HACK
 #define PI 3.14159265359
 #define DEG_2_RAD 0.01745329251994329547437168059786927187815
@@ -21,6 +36,13 @@
 #define WIN_WIDTH  1000
 #define WIN_HEIGHT  800
 
+// Seconds of hull construction per idle callback
+#define HULL_TIME_SLICE 0.03
+
+// Seconds between two uploads of the hull being built (exporting and
+// uploading it is linear in its size)
+#define HULL_UPLOAD_PERIOD 0.5
+
 // Mouse
 int g_MouseButton = GLUT_LEFT_BUTTON;
 int g_MouseState  = GLUT_DOWN;
@@ -39,6 +61,61 @@ Mode g_Mode = FACETS;
 // Points
 Point g_Centroid(0,0,0);
 
+// Where to write the hull once built (format from the extension), and
+// whether to write polygons instead of triangles
+std::string g_ExportPath;
+bool        g_ExportPolygons = false;
+
+// Points to classify against the hull once built
+std::string g_QueryPath;
+
+// Where to write the membership of every input point once the hull is built
+std::string g_MembershipPath;
+
+// Replace the hull by its frozen copy once everything above is done
+bool        g_FreezeHull = false;
+
+// Buffer objects (GL 1.5). gl.h only declares GL 1.1 on Windows, so entry
+// points are loaded at runtime. Without them, the same arrays are drawn from
+// client memory.
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER         0x8892
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#define GL_STATIC_DRAW          0x88E4
+#endif
+
+typedef void (APIENTRY *GenBuffersFunc)(GLsizei, GLuint*);
+typedef void (APIENTRY *BindBufferFunc)(GLenum, GLuint);
+typedef void (APIENTRY *BufferDataFunc)(GLenum, ptrdiff_t, const void*, GLenum);
+
+GenBuffersFunc g_GenBuffers = NULL;
+BindBufferFunc g_BindBuffer = NULL;
+BufferDataFunc g_BufferData = NULL;
+
+// Everything is uploaded once. Points are stored in random order so that any
+// prefix is a uniform sample of the cloud. Hull facets are drawn from one
+// interleaved position/normal array (3 corners per triangle, flat shading) and
+// the wireframe from the vertex array and a list of edge indices.
+enum Buffer { POINT_CLOUD, FACET_CORNERS, HULL_VERTICES, HULL_EDGES, NB_BUFFERS };
+GLuint             g_Buffers[NB_BUFFERS] = { 0, 0, 0, 0 };
+std::vector<float> g_PointCloud;
+GLsizei            g_NbPoints = 0;
+Mesh               g_HullMesh;
+std::vector<float> g_FacetCorners;
+std::vector<float> g_HullVertices;
+std::vector<uint>  g_HullEdges;
+GLsizei            g_NbFacetCorners = 0;
+GLsizei            g_NbHullEdgeIndices = 0;
+
+// Preparation (prefilters, initial conflict graph, or the whole hull for the
+// engines that are not incremental) runs on a worker thread. Only the point
+// cloud is drawn until it is done, the hull globals belong to the worker.
+std::atomic<bool>  g_IsPreparing(false);
+
+// Level of detail: while the camera moves, only this many points are drawn
+bool               g_CameraMoving = false;
+uint               g_NbLODPoints = 1 << 18;
+
 void mouseButton(int i_Button, int i_State, int i_X, int i_Y)
 {
     g_MouseButton = i_Button;
@@ -48,6 +125,12 @@ void mouseButton(int i_Button, int i_State, int i_X, int i_Y)
         g_MouseX = i_X;
         g_MouseY = i_Y;
     }
+
+    // Camera stopped, draw every point again
+    if (i_State == GLUT_UP && g_CameraMoving) {
+        g_CameraMoving = false;
+        glutPostRedisplay();
+    }
 }
 
 void mouseMove(int i_X, int i_Y)
@@ -73,6 +156,7 @@ void mouseMove(int i_X, int i_Y)
         return;
     }
 
+    g_CameraMoving = true;
     glutPostRedisplay();
 }
 
@@ -93,40 +177,341 @@ inline void addCenteredVertex(sPoint i_Pt)
                i_Pt->m_z - g_Centroid.m_z);
 }
 
-void drawConvexHull()
+void drawDegenerateHull()
+{
+    // Polygon, segment or single point
+    if (g_DegenerateHull.m_Dimension == 2) {
+        glBegin(g_Mode == FACETS ? GL_POLYGON : GL_LINE_LOOP);
+    } else if (g_DegenerateHull.m_Dimension == 1) {
+        glBegin(GL_LINES);
+    } else {
+        glBegin(GL_POINTS);
+    }
+
+    Vector& normal(g_DegenerateHull.m_Normal);
+    glColor3f(1, 1, 1);
+    for (uint index : g_DegenerateHull.m_Vertices) {
+        glNormal3d(normal.m_x, normal.m_y, normal.m_z);
+        addCenteredVertex(g_Pts[index]);
+    }
+
+    glEnd();
+}
+
+void* getGLFunction(const char* i_Name)
+{
+#ifdef _WIN32
+    return (void*)wglGetProcAddress(i_Name);
+#else
+    return (void*)glXGetProcAddressARB((const GLubyte*)i_Name);
+#endif
+}
+
+void loadBufferFunctions()
+{
+    // Core since GL 1.5, ARB extension before
+    // Both strings are NULL without a current context (or on error)
+    const char* versionString((const char*)glGetString(GL_VERSION));
+    const char* extensionsString((const char*)glGetString(GL_EXTENSIONS));
+    std::string version(versionString ? versionString : "");
+    std::string extensions(extensionsString ? extensionsString : "");
+    bool isCore(version.compare(0, 3, "1.5") >= 0);
+    if (!isCore && extensions.find("GL_ARB_vertex_buffer_object") == std::string::npos) {
+        std::cout << "No buffer objects, drawing from client memory" << std::endl;
+        return;
+    }
+
+    const char* suffix(isCore ? "" : "ARB");
+    g_GenBuffers = (GenBuffersFunc)getGLFunction((std::string("glGenBuffers") + suffix).c_str());
+    g_BindBuffer = (BindBufferFunc)getGLFunction((std::string("glBindBuffer") + suffix).c_str());
+    g_BufferData = (BufferDataFunc)getGLFunction((std::string("glBufferData") + suffix).c_str());
+    if (!g_GenBuffers || !g_BindBuffer || !g_BufferData) {
+        g_GenBuffers = NULL;
+        return;
+    }
+
+    g_GenBuffers(NB_BUFFERS, g_Buffers);
+}
+
+// Binds the buffer (or nothing in client memory mode) and returns the address
+// to pass to gl*Pointer/glDrawElements for data starting at i_Offset
+template <typename T>
+const char* bindBuffer(GLenum i_Target, Buffer i_Buffer, const std::vector<T>& i_Data, uint i_Offset = 0)
+{
+    if (g_GenBuffers) {
+        g_BindBuffer(i_Target, g_Buffers[i_Buffer]);
+        return (const char*)NULL + i_Offset;
+    }
+    return (const char*)i_Data.data() + i_Offset;
+}
+
+template <typename T>
+void uploadBuffer(GLenum i_Target, Buffer i_Buffer, std::vector<T>& io_Data)
 {
-	std::cout << "Drawing" << std::endl;
-	
-	// For each facet
-    for (sptr<Facet>& facet : g_ConvexHull->m_Facets) {
-        if (!facet) {
-            continue;
+    if (!g_GenBuffers) {
+        return;
+    }
+    g_BindBuffer(i_Target, g_Buffers[i_Buffer]);
+    g_BufferData(i_Target, io_Data.size() * sizeof(T), io_Data.data(), GL_STATIC_DRAW);
+    g_BindBuffer(i_Target, 0);
+
+    // The GPU has its own copy now
+    std::vector<T>().swap(io_Data);
+}
+
+void uploadConvexHull(const Mesh& i_Mesh)
+{
+    const double centroid[3] = { g_Centroid.m_x, g_Centroid.m_y, g_Centroid.m_z };
+
+    // Centered vertices
+    g_HullVertices.resize(i_Mesh.m_Positions.size());
+    for (uint i = 0; i < i_Mesh.m_Positions.size(); ++i) {
+        g_HullVertices[i] = float(i_Mesh.m_Positions[i] - centroid[i % 3]);
+    }
+
+    // Facet corners, with the normal of their facet
+    g_FacetCorners.clear();
+    g_FacetCorners.reserve(i_Mesh.m_Triangles.size() * 6);
+    for (uint corner = 0; corner < i_Mesh.m_Triangles.size(); ++corner) {
+        uint vertex(i_Mesh.m_Triangles[corner]);
+        uint facet(i_Mesh.m_FacetOfTriangle[corner / 3]);
+        g_FacetCorners.insert(g_FacetCorners.end(), &g_HullVertices[3 * vertex], &g_HullVertices[3 * vertex + 3]);
+        for (int axis = 0; axis < 3; ++axis) {
+            g_FacetCorners.push_back(float(i_Mesh.m_Normals[3 * facet + axis]));
         }
+    }
 
-        // Draw each vertex
-        glBegin(g_Mode == FACETS ? GL_POLYGON : GL_LINE_LOOP);
+    // Facet edges, without the diagonals of fan triangulated facets. Each
+    // edge is seen from both its facets, keep it once.
+    g_HullEdges.clear();
+    for (uint triangle = 0; triangle < i_Mesh.nbTriangles(); ++triangle) {
+        uint facet(i_Mesh.m_FacetOfTriangle[triangle]);
+        bool isFirst(triangle == 0 || i_Mesh.m_FacetOfTriangle[triangle - 1] != facet);
+        bool isLast(triangle + 1 == i_Mesh.nbTriangles() || i_Mesh.m_FacetOfTriangle[triangle + 1] != facet);
+        for (uint i = 0; i < 3; ++i) {
+            if ((i == 0 && !isFirst) || (i == 2 && !isLast)) {
+                continue;
+            }
+            uint a(i_Mesh.m_Triangles[3 * triangle + i]);
+            uint b(i_Mesh.m_Triangles[3 * triangle + (i + 1) % 3]);
+            if (a < b) {
+                g_HullEdges.push_back(a);
+                g_HullEdges.push_back(b);
+            }
+        }
+    }
 
-        // Get normal
-        Vector& normal(facet->m_Normal);
+    g_NbFacetCorners = i_Mesh.m_Triangles.size();
+    g_NbHullEdgeIndices = g_HullEdges.size();
 
-        sptr<HalfEdge> edge(facet->m_AnEdge);
-        do {
-			if (edge->m_Twin == edge->m_Next || edge->m_Twin == edge->m_Prev)
-			{
-				glColor3f(1, 0, 0);
-			}
-			else
-			{
-				glColor3f(1, 1, 1);
-			}
-			
-			addCenteredVertex(edge->m_Origin);
-            glNormal3d(normal.m_x, normal.m_y, normal.m_z);
-            edge = edge->m_Next;
-        } while (edge != facet->m_AnEdge);
+    uploadBuffer(GL_ARRAY_BUFFER, FACET_CORNERS, g_FacetCorners);
+    uploadBuffer(GL_ARRAY_BUFFER, HULL_VERTICES, g_HullVertices);
+    uploadBuffer(GL_ELEMENT_ARRAY_BUFFER, HULL_EDGES, g_HullEdges);
+}
 
-        glEnd();
+void uploadPointCloud()
+{
+    g_NbPoints = g_Pts.size();
+    g_PointCloud.resize(3 * g_Pts.size());
+
+    // Centered points, shuffled (Fisher-Yates) while they are copied
+    std::mt19937 generator(0);
+    for (uint i = 0; i < g_Pts.size(); ++i) {
+        uint j(std::uniform_int_distribution<uint>(0, i)(generator));
+        float* dest(&g_PointCloud[3 * i]);
+        float* moved(&g_PointCloud[3 * j]);
+        dest[0] = moved[0];
+        dest[1] = moved[1];
+        dest[2] = moved[2];
+        moved[0] = float(g_Pts[i]->m_x - g_Centroid.m_x);
+        moved[1] = float(g_Pts[i]->m_y - g_Centroid.m_y);
+        moved[2] = float(g_Pts[i]->m_z - g_Centroid.m_z);
     }
+
+    uploadBuffer(GL_ARRAY_BUFFER, POINT_CLOUD, g_PointCloud);
+}
+
+void drawPointCloud()
+{
+    GLsizei nbPoints(g_CameraMoving ? min(g_NbPoints, GLsizei(g_NbLODPoints)) : g_NbPoints);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, bindBuffer(GL_ARRAY_BUFFER, POINT_CLOUD, g_PointCloud));
+    glDrawArrays(GL_POINTS, 0, nbPoints);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    if (g_GenBuffers) {
+        g_BindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+}
+
+void drawConvexHull()
+{
+    // Flat input has no DCEL (a frozen hull is still drawn from the buffers)
+    if (!g_ConvexHull && !g_FrozenHull) {
+        drawDegenerateHull();
+        return;
+    }
+
+    glColor3f(1, 1, 1);
+    glEnableClientState(GL_VERTEX_ARRAY);
+
+    if (g_Mode == FACETS) {
+        GLsizei stride(6 * sizeof(float));
+        glEnableClientState(GL_NORMAL_ARRAY);
+        glVertexPointer(3, GL_FLOAT, stride, bindBuffer(GL_ARRAY_BUFFER, FACET_CORNERS, g_FacetCorners));
+        glNormalPointer(GL_FLOAT, stride, bindBuffer(GL_ARRAY_BUFFER, FACET_CORNERS, g_FacetCorners, 3 * sizeof(float)));
+        glDrawArrays(GL_TRIANGLES, 0, g_NbFacetCorners);
+        glDisableClientState(GL_NORMAL_ARRAY);
+    } else {
+        glVertexPointer(3, GL_FLOAT, 0, bindBuffer(GL_ARRAY_BUFFER, HULL_VERTICES, g_HullVertices));
+        glDrawElements(GL_LINES, g_NbHullEdgeIndices, GL_UNSIGNED_INT,
+                       bindBuffer(GL_ELEMENT_ARRAY_BUFFER, HULL_EDGES, g_HullEdges));
+    }
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+    if (g_GenBuffers) {
+        g_BindBuffer(GL_ARRAY_BUFFER, 0);
+        g_BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+}
+
+void classifyQueryPoints()
+{
+    // Read queries
+    std::ifstream file(g_QueryPath);
+    if (!file) {
+        std::cerr << "Invalid file \"" << g_QueryPath << "\"" << std::endl;
+        return;
+    }
+    std::vector<Point> queries;
+    double x, y, z;
+    while (file >> x >> y >> z) {
+        queries.push_back(Point(x, y, z));
+    }
+
+    // Classify them
+    std::clock_t start(std::clock());
+    HullClassifier classifier(*g_ConvexHull);
+    std::vector<unsigned char> locations(queries.size());
+    classifier.classify(queries.data(), queries.size(), locations.data());
+    double seconds(double(std::clock() - start) / CLOCKS_PER_SEC);
+
+    uint nbPerLocation[3] = { 0, 0, 0 };
+    for (unsigned char location : locations) {
+        ++nbPerLocation[location];
+    }
+    std::cout << queries.size() << " query points: " << nbPerLocation[INSIDE] << " inside, " 
+              << nbPerLocation[ON_HULL] << " on the hull, " << nbPerLocation[OUTSIDE] << " outside (" 
+              << seconds << " s)" << std::endl;
+}
+
+void writeMembership()
+{
+    if (g_Membership.empty()) {
+        return;
+    }
+    uint nbPerMembership[3] = { 0, 0, 0 };
+    for (unsigned char membership : g_Membership) {
+        ++nbPerMembership[membership];
+    }
+    std::cout << nbPerMembership[HULL_VERTEX] << " hull vertices, " << nbPerMembership[ON_HULL_FACET]
+              << " points on facets, " << nbPerMembership[INTERIOR_POINT] << " interior points" << std::endl;
+
+    std::ofstream file(g_MembershipPath, std::ios::binary);
+    file.write((const char*)g_Membership.data(), g_Membership.size());
+    if (!file) {
+        std::cerr << "Could not write \"" << g_MembershipPath << "\"" << std::endl;
+        return;
+    }
+    std::cout << "Membership written to \"" << g_MembershipPath << "\"" << std::endl;
+}
+
+void printMassProperties()
+{
+    const double* inertia(g_MassProperties.m_Inertia);
+    std::cout << "Volume " << g_MassProperties.m_Volume << ", area " << g_MassProperties.m_Area 
+              << ", centroid (" << g_MassProperties.m_Centroid.m_x << ", " << g_MassProperties.m_Centroid.m_y 
+              << ", " << g_MassProperties.m_Centroid.m_z << ")" << std::endl;
+    std::cout << "Inertia tensor";
+    for (int row = 0; row < 3; ++row) {
+        std::cout << " (" << inertia[3 * row] << ", " << inertia[3 * row + 1] << ", " << inertia[3 * row + 2] << ")";
+    }
+    std::cout << std::endl;
+}
+
+void freezeHull()
+{
+    freezeConvexHull();
+    if (!g_FrozenHull) {
+        return;
+    }
+    size_t size(g_FrozenHull->memoryUsage());
+    std::cout << "Frozen hull: " << g_FrozenHull->m_NbVertices << " vertices, " << g_FrozenHull->m_NbFacets 
+              << " facets, " << size << " bytes (" << double(size) / max(1u, g_FrozenHull->m_NbVertices) 
+              << " per vertex)" << std::endl;
+}
+
+void buildConvexHull()
+{
+    // Preparation on a worker thread, then insertions by slices. The worker is
+    // detached so that closing the window does not wait for it.
+    static bool s_Started(false);
+    static bool s_IsDone(false);
+    if (!s_Started) {
+        s_Started = true;
+        g_IsPreparing = true;
+        std::thread([]() {
+            s_IsDone = beginConvexHull();
+            g_IsPreparing = false;
+        }).detach();
+        glutSetWindowTitle("ConvexHull3D - preparing");
+        return;
+    }
+    if (g_IsPreparing) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return;
+    }
+    bool isDone(s_IsDone || advanceConvexHull(HULL_TIME_SLICE));
+    s_IsDone = isDone;
+
+    // Show the hull of the points inserted so far
+    static std::chrono::steady_clock::time_point s_LastUpload;
+    auto now(std::chrono::steady_clock::now());
+    if (g_ConvexHull && (isDone || now - s_LastUpload > std::chrono::duration<double>(HULL_UPLOAD_PERIOD))) {
+        g_HullMesh = exportMesh(*g_ConvexHull);
+        uploadConvexHull(g_HullMesh);
+        s_LastUpload = now;
+    }
+
+    if (isDone) {
+        glutIdleFunc(NULL);
+        glutSetWindowTitle("ConvexHull3D");
+        if (!g_ExportPath.empty()) {
+            bool isWritten(g_ConvexHull ? writeMesh(exportMesh(*g_ConvexHull, g_ExportPolygons), g_ExportPath) 
+                                        : writeMesh(exportMesh(g_DegenerateHull, g_Pts), g_ExportPath));
+            if (isWritten) {
+                std::cout << "Hull written to \"" << g_ExportPath << "\"" << std::endl;
+            }
+        }
+        if (!g_QueryPath.empty() && g_ConvexHull) {
+            classifyQueryPoints();
+        }
+        if (g_ComputeMassProperties && g_ConvexHull) {
+            printMassProperties();
+        }
+        if (g_ComputeMembership) {
+            writeMembership();
+        }
+        if (g_FreezeHull) {
+            freezeHull();
+        }
+    } else {
+        std::string title("ConvexHull3D - " + std::to_string(g_NbInsertedPts) + "/" + 
+                          std::to_string(g_NbPtsToInsert) + " points inserted");
+        glutSetWindowTitle(title.c_str());
+    }
+    glutPostRedisplay();
 }
 
 void draw()
@@ -146,11 +531,7 @@ void draw()
         0.0, 0.0, 0.0, 0.0, 1.0, 0.0);
 
     // Draw points
-    glBegin(GL_POINTS);
-    for (sPoint pnt : g_Pts) {
-        addCenteredVertex(pnt);
-    }
-    glEnd();
+    drawPointCloud();
 
     // Toggle lightning
     if (g_Mode == FACETS) {
@@ -160,7 +541,7 @@ void draw()
     }
 
     // Draw convex hull
-    if (g_Mode != POINTS_ONLY) {
+    if (g_Mode != POINTS_ONLY && !g_IsPreparing) {
         drawConvexHull();
     }
 
@@ -183,6 +564,9 @@ void initOpenGL(int argc, char** argv)
     glDepthFunc(GL_LESS);
     glEnable(GL_DEPTH_TEST);
 
+    // Vertex buffers
+    loadBufferFunctions();
+
     // Callbacks
     glutDisplayFunc(draw);
     glutKeyboardFunc(handleKeyboard);
@@ -228,8 +612,65 @@ void readVertexFile(const char* i_Filepath)
 int main(int argc, char** argv)
 {
     // Check that there's a vertex list file path in arguments
-    if (argc != 2) {
+    if (argc < 2) {
         std::cerr << "Expected a vertex list file path in arguments" << std::endl;
+        return 1;
+    }
+
+    // Read options following the vertex list file path
+    for (int i = 2; i < argc; ++i) {
+        std::string option(argv[i]);
+        if (option == "-dedup" && i + 1 < argc) {
+            g_RemoveDuplicates = true;
+            g_SnapTolerance = atof(argv[++i]);
+        } else if (option == "-lowmem") {
+            g_Engine = LOW_MEMORY;
+        } else if (option == "-dag") {
+            g_Engine = HISTORY_DAG;
+        } else if (option == "-trimesh") {
+            g_Engine = TRIANGLE_MESH;
+        } else if (option == "-chan") {
+            g_Engine = OUTPUT_SENSITIVE;
+        } else if (option == "-auto") {
+            g_AutoSelect = true;
+        } else if (option == "-float") {
+            g_UseFloat = true;
+        } else if (option == "-grid" && i + 1 < argc) {
+            g_Engine = TRIANGLE_MESH;
+            g_GridStep = atof(argv[++i]);
+        } else if (option == "-brio") {
+            g_InsertionOrder = BRIO_ORDER;
+        } else if (option == "-kernel" && i + 1 < argc) {
+            g_KernelEpsilon = atof(argv[++i]);
+        } else if (option == "-flatness" && i + 1 < argc) {
+            g_FlatnessTolerance = atof(argv[++i]);
+        } else if (option == "-parallelhorizon" && i + 1 < argc) {
+            g_ParallelHorizonThreshold = atoi(argv[++i]);
+        } else if (option == "-export" && i + 1 < argc) {
+            g_ExportPath = argv[++i];
+        } else if (option == "-classify" && i + 1 < argc) {
+            g_QueryPath = argv[++i];
+        } else if (option == "-membership" && i + 1 < argc) {
+            g_ComputeMembership = true;
+            g_MembershipPath = argv[++i];
+        } else if (option == "-polygons") {
+            g_ExportPolygons = true;
+        } else if (option == "-merge" && i + 1 < argc) {
+            g_CoplanarMergeAngle = atof(argv[++i]) * DEG_2_RAD;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                g_CoplanarMergeDistance = atof(argv[++i]);
+            }
+        } else if (option == "-mass") {
+            g_ComputeMassProperties = true;
+        } else if (option == "-freeze") {
+            g_FreezeHull = true;
+        } else if (option == "-lod" && i + 1 < argc) {
+            g_NbLODPoints = max(1, atoi(argv[++i]));
+        } else if (option == "-threads" && i + 1 < argc) {
+            nbThreads() = max(1, atoi(argv[++i]));
+        } else {
+            std::cerr << "Unknown option \"" << option << "\"" << std::endl;
+        }
     }
 
     // Initialize OpenGL
@@ -238,8 +679,9 @@ int main(int argc, char** argv)
     // Read vertex in file
     readVertexFile(argv[1]);
 
-    // Compute convex hull
-    compute3DConvexHull();
+    // Upload points once, the hull is built while rendering
+    uploadPointCloud();
+    glutIdleFunc(buildConvexHull);
 
     // Start main rendering loop
     glutMainLoop();